@@ -5,8 +5,12 @@
 #include "aizo_sort.hpp"
 #include "aizo_ds.hpp"
 
+#include <array>
 #include <fmt/core.h>
 #include <fstream>
+#include <string_view>
+#include <thread>
+#include <utility>
 
 namespace aizo::measure {
 
@@ -2209,6 +2213,172 @@ void insertionBinaryDescending(Itr backInserter, std::size_t sampleSize = 25) {
   }());
 }
 
+template< typename Itr, typename Type, std::size_t... arraySizes >
+requires std::output_iterator< Itr, std::string >
+void quickParallelScaling(Itr         backInserter,
+                          std::size_t maxThreads,
+                          std::size_t sampleSize = 25) {
+  *backInserter++ = "Threads;ArraySize;SampleSize;AvgTime;MinTime;MaxTime;Unit";
+
+  for (std::size_t threads = 1; threads <= maxThreads; ++threads) {
+    (..., [&]() {
+      std::size_t      samples   = 0;
+      auto             minTime   = std::numeric_limits< double >::max();
+      auto             maxTime   = std::numeric_limits< double >::min();
+      double           totalTime = 0;
+      std::string_view unit{};
+
+      for (std::size_t i = 0; i < sampleSize; ++i) {
+        tool::ArrayGenerator< Type > gen{ arraySizes };
+        auto                         arr = gen.generatePureRandom(0, 1000);
+
+        tool::Timer timedSort{ [&arr, threads] {
+          sort::quick::parallel(
+            std::begin(arr), std::end(arr), std::less<>{}, threads);
+        } };
+
+        timedSort();
+
+        const auto durationStr = timedSort.getDurationStr();
+        const auto time        = durationStr.first;
+        unit                   = durationStr.second;
+        ++samples;
+        minTime = std::min(minTime, time);
+        maxTime = std::max(maxTime, time);
+        totalTime += time;
+      }
+
+      const auto avgTime = totalTime / static_cast< double >(samples);
+
+      *backInserter++ = fmt::format("{};{};{};{:.4f};{:.4f};{:.4f};{}",
+                                    threads,
+                                    arraySizes,
+                                    samples,
+                                    avgTime,
+                                    minTime,
+                                    maxTime,
+                                    unit);
+    }());
+  }
+}
+
+template< typename Itr, typename Type, std::size_t... arraySizes >
+requires std::output_iterator< Itr, std::string >
+void mergeParallelScaling(Itr         backInserter,
+                          std::size_t maxThreads,
+                          std::size_t sampleSize = 25) {
+  *backInserter++ = "Threads;ArraySize;SampleSize;AvgTime;MinTime;MaxTime;Unit";
+
+  for (std::size_t threads = 1; threads <= maxThreads; ++threads) {
+    (..., [&]() {
+      std::size_t      samples   = 0;
+      auto             minTime   = std::numeric_limits< double >::max();
+      auto             maxTime   = std::numeric_limits< double >::min();
+      double           totalTime = 0;
+      std::string_view unit{};
+
+      for (std::size_t i = 0; i < sampleSize; ++i) {
+        tool::ArrayGenerator< Type > gen{ arraySizes };
+        auto                         arr = gen.generatePureRandom(0, 1000);
+
+        tool::Timer timedSort{ [&arr, threads] {
+          sort::merge::parallel(
+            std::begin(arr), std::end(arr), std::less<>{}, threads);
+        } };
+
+        timedSort();
+
+        const auto durationStr = timedSort.getDurationStr();
+        const auto time        = durationStr.first;
+        unit                   = durationStr.second;
+        ++samples;
+        minTime = std::min(minTime, time);
+        maxTime = std::max(maxTime, time);
+        totalTime += time;
+      }
+
+      const auto avgTime = totalTime / static_cast< double >(samples);
+
+      *backInserter++ = fmt::format("{};{};{};{:.4f};{:.4f};{:.4f};{}",
+                                    threads,
+                                    arraySizes,
+                                    samples,
+                                    avgTime,
+                                    minTime,
+                                    maxTime,
+                                    unit);
+    }());
+  }
+}
+
+template< typename Itr,
+          typename Type,
+          std::size_t... arraySizes,
+          typename SortFunction >
+requires std::output_iterator< Itr, std::string > &&
+         std::invocable< SortFunction,
+                         typename ds::DynamicArray< Type >::iterator,
+                         typename ds::DynamicArray< Type >::iterator >
+void custom(Itr          backInserter,
+            SortFunction sortFunction,
+            std::size_t  sampleSize = 25) {
+  using Generator = tool::ArrayGenerator< Type >;
+  using Generate  = ds::DynamicArray< Type > (Generator::*)(Type, Type);
+
+  const std::array< std::pair< std::string_view, Generate >, 7 > kinds{ {
+    { "PureRandom", &Generator::generatePureRandom },
+    { "SortedAsc", &Generator::generateSortedAscending },
+    { "SortedDesc", &Generator::generateSortedDescending },
+    { "OneThirdAsc", &Generator::generateOneThirdSortedAscending },
+    { "OneThirdDesc", &Generator::generateOneThirdSortedDescending },
+    { "TwoThirdsAsc", &Generator::generateTwoThirdsSortedAscending },
+    { "TwoThirdsDesc", &Generator::generateTwoThirdsSortedDescending },
+  } };
+
+  *backInserter++ =
+    "KindOfRandom;ArraySize;SampleSize;AvgTime;MinTime;MaxTime;Unit";
+
+  for (const auto& [kind, generate] : kinds) {
+    (..., [&]() {
+      std::size_t      samples   = 0;
+      auto             minTime   = std::numeric_limits< double >::max();
+      auto             maxTime   = std::numeric_limits< double >::min();
+      double           totalTime = 0;
+      std::string_view unit{};
+
+      for (std::size_t i = 0; i < sampleSize; ++i) {
+        Generator gen{ arraySizes };
+        auto      arr = (gen.*generate)(Type{ 0 }, Type{ 1000 });
+
+        tool::Timer timedSort{ [&arr, &sortFunction] {
+          sortFunction(std::begin(arr), std::end(arr));
+        } };
+
+        timedSort();
+
+        const auto durationStr = timedSort.getDurationStr();
+        const auto time        = durationStr.first;
+        unit                   = durationStr.second;
+        ++samples;
+        minTime = std::min(minTime, time);
+        maxTime = std::max(maxTime, time);
+        totalTime += time;
+      }
+
+      const auto avgTime = totalTime / static_cast< double >(samples);
+
+      *backInserter++ = fmt::format("{};{};{};{:.4f};{:.4f};{:.4f};{}",
+                                    kind,
+                                    arraySizes,
+                                    samples,
+                                    avgTime,
+                                    minTime,
+                                    maxTime,
+                                    unit);
+    }());
+  }
+}
+
 void allToFiles(std::size_t sampleSize = 25) {
   ds::DynamicArray< std::string > results{};
   std::ofstream              file{};
@@ -2339,6 +2509,325 @@ void allToFiles(std::size_t sampleSize = 25) {
                              3500 >(std::back_inserter(results), sampleSize);
   file.open("results_insertionsort_binary.csv");
   for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Dual-Pivot Quick Sort, pivot strategies
+  results.emplace_back("Results: int, Ascending, Middle");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::quick::dualPivot< sort::quick::pivot::Middle >(begin, end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, MedianOfThree");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::quick::dualPivot< sort::quick::pivot::MedianOfThree >(begin, end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Ninther");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::quick::dualPivot< sort::quick::pivot::Ninther >(begin, end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, PseudoRandom");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::quick::dualPivot< sort::quick::pivot::PseudoRandom >(begin, end);
+    },
+    sampleSize);
+  file.open("results_quicksort_dualpivot.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Parallel Quick Sort, thread scaling
+  const auto maxThreads =
+    std::max< std::size_t >(std::thread::hardware_concurrency(), 1);
+  results.emplace_back("Results: int, Ascending");
+  quickParallelScaling< Inserter, int, 1000000, 5000000 >(
+    std::back_inserter(results), maxThreads, sampleSize);
+  results.emplace_back("\nResults: float, Ascending");
+  quickParallelScaling< Inserter, float, 1000000, 5000000 >(
+    std::back_inserter(results), maxThreads, sampleSize);
+  file.open("results_quicksort_parallel.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Radix Sort against Quick Sort
+  results.emplace_back("Results: int, Ascending, Radix LSD");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::radix::lsd(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Radix MSD");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::radix::msd(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Quick Classic");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::classic(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: float, Ascending, Radix LSD");
+  custom< Inserter, float, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::radix::lsd(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: float, Ascending, Radix MSD");
+  custom< Inserter, float, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::radix::msd(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: float, Ascending, Quick Classic");
+  custom< Inserter, float, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::classic(begin, end); },
+    sampleSize);
+  file.open("results_radixsort.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Sorting networks as the base case of Introspective Quick Sort
+  results.emplace_back("Results: int, Ascending, Insertion");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::intro(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Network 16");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::intro< 16 >(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Network 32");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::intro< 32 >(begin, end); },
+    sampleSize);
+  file.open("results_quicksort_network.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Three-Way Quick Sort, custom includes the SortedAsc and SortedDesc kinds
+  results.emplace_back("Results: int, Ascending, Quick Three-Way");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::threeWay(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Descending, Quick Three-Way");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::quick::threeWay(begin, end, std::greater<>{});
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Quick Introspective");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::intro(begin, end); },
+    sampleSize);
+  file.open("results_quicksort_threeway.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Merge Sort, natural runs
+  results.emplace_back("Results: int, Ascending, TimSort");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::merge::tim(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Bottom-Up Merge");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::merge::bottomUp(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Quick Introspective");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::intro(begin, end); },
+    sampleSize);
+  file.open("results_mergesort.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Heap Sort variants
+  results.emplace_back("Results: int, Ascending, Heap Classic");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::heap::classic(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Heap Bottom-Up");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::heap::bottomUp(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Heap 4-ary");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::heap::dary< 4 >(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Heap 8-ary");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::heap::dary< 8 >(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Heap 16-ary");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::heap::dary< 16 >(begin, end); },
+    sampleSize);
+  file.open("results_heapsort_variants.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Parallel Merge Sort, thread scaling
+  results.emplace_back("Results: int, Ascending");
+  mergeParallelScaling< Inserter, int, 1000000, 5000000 >(
+    std::back_inserter(results), maxThreads, sampleSize);
+  results.emplace_back("\nResults: float, Ascending");
+  mergeParallelScaling< Inserter, float, 1000000, 5000000 >(
+    std::back_inserter(results), maxThreads, sampleSize);
+  file.open("results_mergesort_parallel.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Shell Sort, gap sequences
+  results.emplace_back("Results: int, Ascending, Shell Ciura");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::shell::classic< sort::shell::gaps::Ciura >(begin, end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Shell Tokuda");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::shell::classic< sort::shell::gaps::Tokuda >(begin, end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Shell Sedgewick");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::shell::classic< sort::shell::gaps::Sedgewick >(begin, end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Shell Pratt");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::shell::classic< sort::shell::gaps::Pratt >(begin, end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Insertion Classic");
+  custom< Inserter, int, 1000, 2000, 3000, 4000, 5000, 6000, 7000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::insertion::classic(begin, end); },
+    sampleSize);
+  file.open("results_shellsort.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Adaptive Sort against Pattern-Defeating Quick Sort
+  results.emplace_back("Results: int, Ascending, Adaptive");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::adaptive(begin, end); },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Quick Pattern-Defeating");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) { sort::quick::pdq(begin, end); },
+    sampleSize);
+  file.open("results_adaptive.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Partial Sort, smallest 1% and 25% of the range
+  results.emplace_back("Results: int, Ascending, 1%, Heap Partial");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::heap::partial(
+        begin, std::next(begin, std::distance(begin, end) / 100), end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, 25%, Heap Partial");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::heap::partial(
+        begin, std::next(begin, std::distance(begin, end) / 4), end);
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, 25%, Quick Partial");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::quick::partial(
+        begin, std::next(begin, std::distance(begin, end) / 4), end);
+    },
+    sampleSize);
+  file.open("results_partialsort.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Selection
+  results.emplace_back("Results: int, Ascending, Median");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      static_cast< void >(sort::select::median(begin, end));
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, 99th Percentile");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      sort::select::nthElement(
+        begin, std::next(begin, std::distance(begin, end) * 99 / 100), end);
+    },
+    sampleSize);
+  file.open("results_select.csv");
+  for (const auto& line : results) { file << line << '\n'; }
+  file.close();
+  results.clear();
+
+  // Indirect Sort
+  results.emplace_back("Results: int, Ascending, Argsort");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      static_cast< void >(sort::argsort(begin, end));
+    },
+    sampleSize);
+  results.emplace_back("\nResults: int, Ascending, Argsort and Permute");
+  custom< Inserter, int, 1000000, 2000000, 3000000 >(
+    std::back_inserter(results),
+    [](auto begin, auto end) {
+      const auto indices = sort::argsort(begin, end);
+      sort::applyPermutation(begin, end, std::begin(indices));
+    },
+    sampleSize);
+  file.open("results_indirect.csv");
+  for (const auto& line : results) { file << line << '\n'; }
 }
 
 } // namespace aizo::measure
@@ -7,8 +7,18 @@
 namespace aizo::sort {
 }
 
+#include "aizo_sort_adaptive.hpp"
+#include "aizo_sort_external.hpp"
 #include "aizo_sort_insertion.hpp"
 #include "aizo_sort_heap.hpp"
+#include "aizo_sort_indirect.hpp"
+#include "aizo_sort_merge.hpp"
+#include "aizo_sort_network.hpp"
 #include "aizo_sort_quick.hpp"
+#include "aizo_sort_radix.hpp"
+#include "aizo_sort_sample.hpp"
+#include "aizo_sort_select.hpp"
+#include "aizo_sort_shell.hpp"
+#include "aizo_sort_string.hpp"
 
 #endif // UNI_AIZO_P_AIZO_SORT_HPP
@@ -0,0 +1,112 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_ADAPTIVE_HPP
+#define UNI_AIZO_P_AIZO_SORT_ADAPTIVE_HPP
+
+#include "aizo_sort_adaptive_impl.hpp"
+#include "aizo_sort_heap.hpp"
+#include "aizo_sort_insertion.hpp"
+#include "aizo_sort_merge.hpp"
+#include "aizo_sort_quick.hpp"
+#include "aizo_sort_radix.hpp"
+
+namespace aizo::sort {
+
+/**
+ * @brief Sorting engines picked by the adaptive sort.
+ */
+enum class Engine : std::uint8_t {
+  INSERTION,
+  TIM,
+  THREE_WAY,
+  RADIX,
+  QUICK,
+  HEAP
+};
+
+/**
+ * @brief Adaptive sort, picks the engine from the properties of the input.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n) for presorted ranges and radix keys.
+ * @headerfile aizo_sort_adaptive.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Engine that sorted the range.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Small ranges go to binary insertion sort. Larger ones are
+ * profiled with impl::profile, a few hundred comparisons on a sample:
+ * - Few runs, estimated from the changes of direction between neighbours so
+ * ascending and descending runs count alike, or nearly sorted in either
+ * direction: merge::tim, or heap::bottomUp for elements that cannot be
+ * buffered.
+ * - Integer or floating point keys in std::less or std::greater order on
+ * large ranges, or on medium ranges with keys spanning few digits:
+ * radix::lsd.
+ * - Many duplicates: quick::threeWay.
+ * - Otherwise: quick::pdq.
+ * Not stable in general, the engine is returned for logging and tuning.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr Engine adaptive(Itr begin, Itr end, Compare compare = Compare{}) {
+  using Type = std::iter_value_t< Itr >;
+
+  constexpr bool radixKeys =
+    radix::impl::isKey< Type > &&
+    (radix::impl::isAscending< Compare, Type > ||
+     radix::impl::isDescending< Compare, Type >);
+
+  const auto size = std::distance(begin, end);
+
+  if (size <= impl::adaptiveInsertionThreshold) {
+    insertion::binary(begin, end, compare);
+    return Engine::INSERTION;
+  }
+
+  const auto profile = impl::profile(begin, end, compare);
+
+  const bool presorted =
+    profile.runs * impl::presortedRunLength <= static_cast< double >(size) ||
+    profile.inversions <= impl::presortedInversions ||
+    profile.inversions >= 1 - impl::presortedInversions;
+
+  if (presorted) {
+    if constexpr (std::is_default_constructible_v< Type >) {
+      merge::tim(begin, end, compare);
+      return Engine::TIM;
+    } else {
+      heap::bottomUp(begin, end, compare);
+      return Engine::HEAP;
+    }
+  }
+
+  if constexpr (radixKeys) {
+    if (size >= impl::adaptiveRadixThreshold ||
+        (size >= impl::adaptiveNarrowRadixThreshold &&
+         profile.keyDigits <= impl::narrowDigits)) {
+      radix::lsd(begin, end, compare);
+      return Engine::RADIX;
+    }
+  }
+
+  if (profile.duplicates >= impl::manyDuplicates) {
+    quick::threeWay(begin, end, compare);
+    return Engine::THREE_WAY;
+  }
+
+  quick::pdq(begin, end, compare);
+  return Engine::QUICK;
+}
+
+} // namespace aizo::sort
+
+#endif // UNI_AIZO_P_AIZO_SORT_ADAPTIVE_HPP
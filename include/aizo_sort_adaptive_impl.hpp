@@ -0,0 +1,210 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_ADAPTIVE_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_ADAPTIVE_IMPL_HPP
+
+#include "aizo_sort_radix_impl.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief Implementation specific functionality for the adaptive sort.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::impl {
+
+/**
+ * @brief Ranges of this size or smaller are sorted with insertion sort
+ * without profiling.
+ */
+inline constexpr std::ptrdiff_t adaptiveInsertionThreshold = 64;
+
+/**
+ * @brief Ranges of this size or larger with radix keys are sorted with radix
+ * sort.
+ */
+inline constexpr std::ptrdiff_t adaptiveRadixThreshold = 1 << 16;
+
+/**
+ * @brief Ranges of this size or larger whose sampled keys span few digits
+ * are sorted with radix sort.
+ */
+inline constexpr std::ptrdiff_t adaptiveNarrowRadixThreshold = 1 << 10;
+
+/**
+ * @brief Sampled keys spanning this many radix digits or fewer are narrow.
+ */
+inline constexpr std::size_t narrowDigits = 2;
+
+/**
+ * @brief Number of windows of neighbours checked for run boundaries.
+ */
+inline constexpr std::ptrdiff_t sampleWindows = 16;
+
+/**
+ * @brief Number of neighbour pairs checked in every window.
+ */
+inline constexpr std::ptrdiff_t sampleWindowPairs = 16;
+
+/**
+ * @brief Largest number of elements sampled for inversions and duplicates.
+ */
+inline constexpr std::ptrdiff_t maxSamples = 128;
+
+/**
+ * @brief Average estimated run length from which a range counts as made of
+ * few runs, ascending or descending.
+ */
+inline constexpr double presortedRunLength = 10;
+
+/**
+ * @brief Fraction of sampled inversions up to which, or from one minus which,
+ * a range counts as nearly sorted.
+ */
+inline constexpr double presortedInversions = 0.05;
+
+/**
+ * @brief Fraction of duplicated sampled elements from which a range counts as
+ * low-cardinality.
+ */
+inline constexpr double manyDuplicates = 0.5;
+
+/**
+ * @brief Properties of a range estimated from a sample.
+ *
+ * @details Estimated number of runs, fractions of sampled pairs out of order
+ * and of sampled elements equal to another one, and the number of radix
+ * digits spanned by the sampled keys.
+ */
+struct Profile {
+  double      runs;
+  double      inversions;
+  double      duplicates;
+  std::size_t keyDigits;
+};
+
+/**
+ * @brief Estimate the properties of a range.
+ * @headerfile aizo_sort_adaptive_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Estimated properties.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires more than adaptiveInsertionThreshold elements.
+ *
+ * @details Counts run boundaries, changes of direction between consecutive
+ * neighbour pairs, in windows spread over the range and scales their
+ * fraction to the size of the range to estimate the number of runs. Runs in
+ * either direction count alike, equal neighbours continue the current run.
+ * Insertion sorts the positions of up to
+ * maxSamples evenly spaced elements by their value: the number of shifts is
+ * the number of inversions among them, and equal neighbours in the result are
+ * duplicates. For radix keys the span of the sampled keys is measured in
+ * digits. The range itself is not modified, O(maxSamples^2) comparisons at
+ * most.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr >
+[[nodiscard]] constexpr Profile profile(Itr begin, Itr end, Compare compare) {
+  using Type = std::iter_value_t< Itr >;
+
+  const auto size = std::distance(begin, end);
+  Profile    result{};
+
+  // Run boundaries in windows of neighbours
+  const auto     pairs       = std::min(sampleWindowPairs, size - 1);
+  std::ptrdiff_t boundaries  = 0;
+  std::ptrdiff_t transitions = 0;
+  for (std::ptrdiff_t window = 0; window < sampleWindows; ++window) {
+    const auto first = (size - 1 - pairs) * window / (sampleWindows - 1);
+
+    // Direction of the current run, 0 while only equal neighbours were seen
+    int direction = 0;
+    for (auto index = first; index < first + pairs; ++index) {
+      const auto& current = *std::next(begin, index);
+      const auto& next    = *std::next(begin, index + 1);
+
+      const int step = compare(current, next)   ? 1
+                       : compare(next, current) ? -1
+                                                : 0;
+      if (step == 0) { continue; }
+
+      if (direction != 0) {
+        ++transitions;
+        boundaries += step != direction ? 1 : 0;
+      }
+      direction = step;
+    }
+  }
+  result.runs = 1;
+  if (transitions > 0) {
+    result.runs += static_cast< double >(boundaries) *
+                   static_cast< double >(size - 1) /
+                   static_cast< double >(transitions);
+  }
+
+  // Inversions and duplicates of evenly spaced elements
+  const auto samples =
+    std::min(maxSamples, std::max< std::ptrdiff_t >(size / 16, 2));
+  std::array< std::ptrdiff_t, maxSamples > positions{};
+  std::ptrdiff_t                           inversions = 0;
+  for (std::ptrdiff_t sample = 0; sample < samples; ++sample) {
+    const auto  position = (size - 1) * sample / (samples - 1);
+    const auto& value    = *std::next(begin, position);
+
+    auto hole = sample;
+    for (; hole > 0 && compare(value, *std::next(begin, positions[hole - 1]));
+         --hole) {
+      positions[hole] = positions[hole - 1];
+    }
+    positions[hole] = position;
+    inversions += sample - hole;
+  }
+  result.inversions = static_cast< double >(inversions) * 2 /
+                      static_cast< double >(samples * (samples - 1));
+
+  std::ptrdiff_t duplicates = 0;
+  for (std::ptrdiff_t sample = 1; sample < samples; ++sample) {
+    duplicates += compare(*std::next(begin, positions[sample - 1]),
+                          *std::next(begin, positions[sample]))
+                    ? 0
+                    : 1;
+  }
+  result.duplicates =
+    static_cast< double >(duplicates) / static_cast< double >(samples);
+
+  // Span of the sampled keys in radix digits
+  if constexpr (radix::impl::isKey< Type >) {
+    const auto lowest =
+      radix::impl::toKey< false >(*std::next(begin, positions[0]));
+    const auto highest =
+      radix::impl::toKey< false >(*std::next(begin, positions[samples - 1]));
+    const auto span = static_cast< std::uint64_t >(
+      highest > lowest ? highest - lowest : lowest - highest);
+
+    result.keyDigits =
+      (static_cast< std::size_t >(std::bit_width(span)) +
+       radix::impl::digitBits - 1) /
+      radix::impl::digitBits;
+  } else {
+    result.keyDigits = sizeof(Type);
+  }
+
+  return result;
+}
+
+} // namespace aizo::sort::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_ADAPTIVE_IMPL_HPP
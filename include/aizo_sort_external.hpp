@@ -0,0 +1,125 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_EXTERNAL_HPP
+#define UNI_AIZO_P_AIZO_SORT_EXTERNAL_HPP
+
+#include "aizo_sort_external_impl.hpp"
+
+/**
+ * @brief External sorting, for data larger than the memory.
+ */
+namespace aizo::sort::external {
+
+/**
+ * @brief File formats.
+ *
+ * @details TEXT is the format size data1 data2 ... dataN of
+ * tool::ArrayReader, BINARY holds the raw values in native byte order.
+ */
+enum class Format : std::uint8_t {
+  TEXT,
+  BINARY
+};
+
+/**
+ * @brief Settings of an external sort.
+ *
+ * @details The memory budget in bytes bounds all buffers of values: chunk
+ * buffers while generating runs and block buffers while merging. Temporary
+ * run files go to the temporary directory and are removed afterwards.
+ */
+struct Config {
+  std::size_t           memoryBudget  = std::size_t{ 256 } << 20;
+  std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+  Format                inputFormat   = Format::TEXT;
+  Format                outputFormat  = Format::TEXT;
+};
+
+/**
+ * @brief External merge sort of a file.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n log_k(n / m)) I/O for a budget of m
+ * values and k runs merged at once.
+ * @headerfile aizo_sort_external.hpp
+ *
+ * @tparam Type Type of the values.
+ * @tparam Compare Comparison function type.
+ * @param input Path of the file to sort.
+ * @param output Path of the sorted file.
+ * @param config Memory budget, temporary directory and formats.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Type to be arithmetic.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ * @throws std::invalid_argument if the memory budget is below 6 blocks of
+ * impl::minBlockBytes.
+ * @throws std::runtime_error if a file cannot be read or written.
+ *
+ * @details Inputs that fit in the budget are sorted in memory. Otherwise the
+ * input is read in chunks of a third of the budget, every chunk is sorted
+ * with quick::pdq and spilled to a temporary run file. Reading the next
+ * chunk and writing the previous run overlap with sorting. The runs are then
+ * merged with a loser tree, with read-ahead of every run and write-behind of
+ * the output. If giving every run two blocks of at least impl::minBlockBytes
+ * would exceed the budget, groups of runs are merged into longer runs first.
+ * Not stable within a chunk.
+ */
+template< typename Type = int, typename Compare = std::less<> >
+requires std::is_arithmetic_v< Type > &&
+         std::is_same_v< std::invoke_result_t< Compare, Type, Type >, bool >
+void sortFile(const std::filesystem::path& input,
+              const std::filesystem::path& output,
+              const Config&                config  = Config{},
+              Compare                      compare = Compare{}) {
+  const auto budget   = config.memoryBudget / sizeof(Type);
+  const auto minBlock = impl::minBlockBytes / sizeof(Type);
+  if (budget < 6 * minBlock) {
+    throw std::invalid_argument{ "Memory budget too small." };
+  }
+
+  impl::InputFile< Type > source{ input, config.inputFormat == Format::TEXT };
+  const auto              size = source.size();
+  const bool              text = config.outputFormat == Format::TEXT;
+
+  // Everything fits, a single sort in memory
+  if (size <= budget) {
+    ds::DynamicArray< Type > data(size);
+    static_cast< void >(source.read(data.data(), size));
+    quick::pdq(data.data(), data.data() + size, compare);
+
+    impl::OutputFile< Type > target{ output, text, size };
+    target.write(data.data(), size);
+    target.close();
+    return;
+  }
+
+  impl::TempFiles temp{ config.tempDirectory };
+  auto            runs  = impl::generateRuns(source, temp, budget / 3, compare);
+  std::size_t     first = 0;
+
+  // Merge groups of runs until one merge fits in the budget
+  const auto fanIn = budget / (2 * minBlock) - 1;
+  while (runs > fanIn) {
+    std::size_t merged = 0;
+
+    for (auto group = first; group < first + runs; group += fanIn) {
+      const auto count = std::min(fanIn, first + runs - group);
+
+      impl::OutputFile< Type > target{ temp.path(temp.next()), false, 0 };
+      impl::mergeRuns(temp, group, count, target, budget, compare);
+      target.close();
+
+      for (auto run = group; run < group + count; ++run) { temp.remove(run); }
+      ++merged;
+    }
+
+    first += runs;
+    runs   = merged;
+  }
+
+  impl::OutputFile< Type > target{ output, text, size };
+  impl::mergeRuns(temp, first, runs, target, budget, compare);
+  target.close();
+}
+
+} // namespace aizo::sort::external
+
+#endif // UNI_AIZO_P_AIZO_SORT_EXTERNAL_HPP
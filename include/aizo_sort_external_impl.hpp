@@ -0,0 +1,571 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_EXTERNAL_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_EXTERNAL_IMPL_HPP
+
+#include "aizo_ds_dynamicarray.hpp"
+#include "aizo_sort_merge_impl.hpp"
+#include "aizo_sort_quick.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Implementation specific functionality for external sorting.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::external::impl {
+
+/**
+ * @brief Smallest block read from a run at once while merging, fewer runs
+ * are merged per pass rather than using smaller blocks.
+ */
+inline constexpr std::size_t minBlockBytes = std::size_t{ 1 } << 16;
+
+/**
+ * @brief Size of the stream buffers of text files, binary files are read and
+ * written in whole blocks.
+ */
+inline constexpr std::size_t streamBufferBytes = std::size_t{ 1 } << 20;
+
+/**
+ * @brief Longest text representation of a value, separator included.
+ */
+inline constexpr std::size_t maxTextLength = 64;
+
+/**
+ * @brief File of arithmetic values read in chunks.
+ * @headerfile aizo_sort_external_impl.hpp
+ *
+ * @tparam Type Type of the values.
+ *
+ * @details Text files have the format size data1 data2 ... dataN of
+ * tool::ArrayReader, binary files hold the raw values and their size follows
+ * from the file size.
+ */
+template< typename Type >
+requires std::is_arithmetic_v< Type >
+class InputFile {
+public:
+  /**
+   * @brief Open the file and read the size.
+   * @param path Path of the file.
+   * @param textFormat Whether the file is in the text format.
+   * @throws std::runtime_error if the file cannot be opened or the size is
+   * invalid.
+   */
+  InputFile(const std::filesystem::path& path, bool textFormat):
+    text{ textFormat }, buffer(textFormat ? streamBufferBytes : 0) {
+    if (text) {
+      stream.rdbuf()->pubsetbuf(
+        buffer.data(), static_cast< std::streamsize >(buffer.size()));
+    }
+    stream.open(path, text ? std::ios::in : std::ios::in | std::ios::binary);
+    if (!stream) { throw std::runtime_error{ "Cannot open input file." }; }
+
+    if (text) {
+      stream >> remaining;
+      if (!stream) { throw std::runtime_error{ "Invalid input size." }; }
+    } else {
+      const auto bytes = std::filesystem::file_size(path);
+      if (bytes % sizeof(Type) != 0) {
+        throw std::runtime_error{ "Invalid input size." };
+      }
+      remaining = bytes / sizeof(Type);
+    }
+    total = remaining;
+  }
+
+  /**
+   * @brief Get the number of values in the file.
+   * @note Nodiscard.
+   * @return Number of values.
+   */
+  [[nodiscard]] std::size_t size() const {
+    return total;
+  }
+
+  /**
+   * @brief Read the next values.
+   * @param data Pointer to the storage of the values.
+   * @param capacity Largest number of values to read.
+   * @throws std::runtime_error if the file ends early.
+   * @return Number of values read, 0 at the end of the file.
+   */
+  std::size_t read(Type* data, std::size_t capacity) {
+    const auto count = std::min(capacity, remaining);
+
+    if (text) {
+      for (std::size_t index = 0; index < count; ++index) {
+        stream >> data[index];
+      }
+    } else {
+      stream.read(reinterpret_cast< char* >(data),
+                  static_cast< std::streamsize >(count * sizeof(Type)));
+    }
+    if (!stream) { throw std::runtime_error{ "Input file ended early." }; }
+
+    remaining -= count;
+    return count;
+  }
+
+private:
+  bool                     text;
+  ds::DynamicArray< char > buffer;
+  std::ifstream            stream{};
+  std::size_t              remaining{ 0 };
+  std::size_t              total{ 0 };
+};
+
+/**
+ * @brief File of arithmetic values written in chunks.
+ * @headerfile aizo_sort_external_impl.hpp
+ *
+ * @tparam Type Type of the values.
+ *
+ * @details Same formats as InputFile. Text values are formatted with
+ * std::to_chars, one per line.
+ */
+template< typename Type >
+requires std::is_arithmetic_v< Type >
+class OutputFile {
+public:
+  /**
+   * @brief Create the file and write the size.
+   * @param path Path of the file.
+   * @param textFormat Whether to write the text format.
+   * @param size Number of values that will be written.
+   * @throws std::runtime_error if the file cannot be created.
+   */
+  OutputFile(const std::filesystem::path& path,
+             bool                         textFormat,
+             std::size_t                  size):
+    text{ textFormat }, buffer(textFormat ? streamBufferBytes : 0) {
+    if (text) {
+      stream.rdbuf()->pubsetbuf(
+        buffer.data(), static_cast< std::streamsize >(buffer.size()));
+    }
+    stream.open(path,
+                text ? std::ios::out | std::ios::trunc
+                     : std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!stream) { throw std::runtime_error{ "Cannot create output file." }; }
+
+    if (text) { stream << size << '\n'; }
+  }
+
+  /**
+   * @brief Write values.
+   * @param data Pointer to the values.
+   * @param count Number of values.
+   * @throws std::runtime_error if writing fails.
+   */
+  void write(const Type* data, std::size_t count) {
+    if (text) {
+      std::array< char, streamBufferBytes / 16 > line{};
+      auto                                       cursor = line.data();
+
+      for (std::size_t index = 0; index < count; ++index) {
+        if (std::distance(cursor, line.data() + line.size()) <
+            static_cast< std::ptrdiff_t >(maxTextLength)) {
+          stream.write(line.data(), cursor - line.data());
+          cursor = line.data();
+        }
+
+        cursor =
+          std::to_chars(cursor, line.data() + line.size(), data[index]).ptr;
+        *cursor++ = '\n';
+      }
+      stream.write(line.data(), cursor - line.data());
+    } else {
+      stream.write(reinterpret_cast< const char* >(data),
+                   static_cast< std::streamsize >(count * sizeof(Type)));
+    }
+    if (!stream) { throw std::runtime_error{ "Cannot write output file." }; }
+  }
+
+  /**
+   * @brief Flush and close the file.
+   * @throws std::runtime_error if flushing fails.
+   */
+  void close() {
+    stream.close();
+    if (!stream) { throw std::runtime_error{ "Cannot write output file." }; }
+  }
+
+private:
+  bool                     text;
+  ds::DynamicArray< char > buffer;
+  std::ofstream            stream{};
+};
+
+/**
+ * @brief Temporary run files, removed on destruction.
+ * @headerfile aizo_sort_external_impl.hpp
+ *
+ * @details Every file is created exclusively under a name with a random
+ * token, so processes sharing a directory never truncate each other's runs.
+ */
+class TempFiles {
+public:
+  /**
+   * @brief Prepare to create files in a directory.
+   * @param location Directory of the files.
+   */
+  explicit TempFiles(const std::filesystem::path& location):
+    directory{ location },
+    random{ (static_cast< std::uint64_t >(std::random_device{}()) << 32U) ^
+            static_cast< std::uint64_t >(
+              std::chrono::steady_clock::now().time_since_epoch().count()) } {
+  }
+
+  TempFiles(const TempFiles&)            = delete;
+  TempFiles(TempFiles&&)                 = delete;
+  TempFiles& operator=(const TempFiles&) = delete;
+  TempFiles& operator=(TempFiles&&)      = delete;
+
+  /**
+   * @brief Remove all files that were handed out.
+   */
+  ~TempFiles() {
+    for (std::size_t file = 0; file < paths.size(); ++file) { remove(file); }
+  }
+
+  /**
+   * @brief Create a new empty file under a name no other file has.
+   * @note Nodiscard.
+   * @return Index of the new file.
+   * @throws std::runtime_error if the file cannot be created.
+   */
+  [[nodiscard]] std::size_t next() {
+    for (std::size_t attempt = 0; attempt < maxAttempts; ++attempt) {
+      const auto candidate =
+        directory / ("aizo_external_" + std::to_string(random()) + ".run");
+
+      // Fails instead of truncating if the name is taken
+      auto* const file = std::fopen(candidate.string().c_str(), "wx");
+      if (file != nullptr) {
+        std::fclose(file);
+        paths.emplace_back(candidate);
+        return paths.size() - 1;
+      }
+      if (errno != EEXIST) { break; }
+    }
+
+    throw std::runtime_error{ "Cannot create temporary file." };
+  }
+
+  /**
+   * @brief Get the path of a file.
+   * @note Nodiscard.
+   * @param file Index of the file.
+   * @return Path of the file.
+   */
+  [[nodiscard]] const std::filesystem::path& path(std::size_t file) const {
+    return paths[file];
+  }
+
+  /**
+   * @brief Remove a file early, once it is no longer needed.
+   * @param file Index of the file.
+   */
+  void remove(std::size_t file) const {
+    std::error_code ignored{};
+    std::filesystem::remove(path(file), ignored);
+  }
+
+private:
+  /**
+   * @brief Number of names tried before giving up.
+   */
+  static constexpr std::size_t maxAttempts = 16;
+
+  std::filesystem::path                     directory;
+  std::mt19937_64                           random;
+  ds::DynamicArray< std::filesystem::path > paths{};
+};
+
+/**
+ * @brief Sorted run read in blocks with read-ahead.
+ * @headerfile aizo_sort_external_impl.hpp
+ *
+ * @tparam Type Type of the values.
+ *
+ * @details While the values of one block are merged, the next block is read
+ * by a background task into a second buffer.
+ */
+template< typename Type >
+class RunReader {
+public:
+  /**
+   * @brief Open a run and read its first block.
+   * @param path Path of the run file.
+   * @param blockSize Number of values per block.
+   */
+  RunReader(const std::filesystem::path& path, std::size_t blockSize):
+    file{ path, false }, current(blockSize), ahead(blockSize) {
+    cursor = current.data();
+    last   = cursor + file.read(current.data(), blockSize);
+    prefetch();
+  }
+
+  RunReader(const RunReader&)            = delete;
+  RunReader(RunReader&&)                 = delete;
+  RunReader& operator=(const RunReader&) = delete;
+  RunReader& operator=(RunReader&&)      = delete;
+  ~RunReader()                           = default;
+
+  /**
+   * @brief Check whether all values were taken.
+   * @note Nodiscard.
+   * @return True if the run is exhausted.
+   */
+  [[nodiscard]] bool exhausted() const {
+    return cursor == last;
+  }
+
+  /**
+   * @brief Get the next value.
+   * @note Nodiscard.
+   * @return Next value of the run.
+   */
+  [[nodiscard]] const Type& head() const {
+    return *cursor;
+  }
+
+  /**
+   * @brief Move to the following value, switching blocks at the end.
+   */
+  void advance() {
+    if (++cursor != last) { return; }
+
+    const auto count = pending.get();
+    if (count == 0) { return; }
+
+    std::swap(current, ahead);
+    cursor = current.data();
+    last   = cursor + count;
+    prefetch();
+  }
+
+private:
+  InputFile< Type >          file;
+  ds::DynamicArray< Type >   current;
+  ds::DynamicArray< Type >   ahead;
+  const Type*                cursor{ nullptr };
+  const Type*                last{ nullptr };
+  std::future< std::size_t > pending{};
+
+  /**
+   * @brief Start reading the next block into the second buffer.
+   */
+  void prefetch() {
+    pending = std::async(std::launch::async, [this] {
+      return file.read(ahead.data(), ahead.size());
+    });
+  }
+};
+
+/**
+ * @brief Output written in blocks with write-behind.
+ * @headerfile aizo_sort_external_impl.hpp
+ *
+ * @tparam Type Type of the values.
+ *
+ * @details While one block is written by a background task, the next one is
+ * filled in a second buffer.
+ */
+template< typename Type >
+class RunWriter {
+public:
+  /**
+   * @brief Prepare the buffers.
+   * @param output File to write to.
+   * @param blockSize Number of values per block.
+   */
+  RunWriter(OutputFile< Type >& output, std::size_t blockSize):
+    file{ output }, current(blockSize), behind(blockSize) {
+    cursor = current.data();
+  }
+
+  RunWriter(const RunWriter&)            = delete;
+  RunWriter(RunWriter&&)                 = delete;
+  RunWriter& operator=(const RunWriter&) = delete;
+  RunWriter& operator=(RunWriter&&)      = delete;
+  ~RunWriter()                           = default;
+
+  /**
+   * @brief Append a value.
+   * @param value Value to append.
+   */
+  void push(const Type& value) {
+    *cursor++ = value;
+    if (cursor == current.data() + current.size()) { flush(); }
+  }
+
+  /**
+   * @brief Write all buffered values and wait for the writes to finish.
+   */
+  void finish() {
+    flush();
+    if (pending.valid()) { pending.get(); }
+  }
+
+private:
+  OutputFile< Type >&      file;
+  ds::DynamicArray< Type > current;
+  ds::DynamicArray< Type > behind;
+  Type*                    cursor{ nullptr };
+  std::future< void >      pending{};
+
+  /**
+   * @brief Hand the filled block to the background task.
+   */
+  void flush() {
+    const auto count = static_cast< std::size_t >(cursor - current.data());
+    if (count == 0) { return; }
+
+    if (pending.valid()) { pending.get(); }
+    std::swap(current, behind);
+    cursor = current.data();
+
+    pending = std::async(std::launch::async, [this, count] {
+      file.write(behind.data(), count);
+    });
+  }
+};
+
+/**
+ * @brief Merge sorted runs into an output file with a loser tree.
+ * @headerfile aizo_sort_external_impl.hpp
+ *
+ * @tparam Type Type of the values.
+ * @tparam Compare Comparison function type.
+ * @param temp Temporary files holding the runs.
+ * @param first Index of the first run.
+ * @param count Number of runs, consecutive indices.
+ * @param output File to write to.
+ * @param budget Number of values that fit in the memory budget.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Splits the budget into two blocks per run and two for the output.
+ * Every output value costs about log2(count) comparisons. Equal values are
+ * taken from the earlier run first, so the merge is stable.
+ */
+template< typename Type, typename Compare >
+void mergeRuns(const TempFiles&    temp,
+               std::size_t         first,
+               std::size_t         count,
+               OutputFile< Type >& output,
+               std::size_t         budget,
+               Compare             compare) {
+  const auto blockSize = budget / (2 * count + 2);
+
+  ds::DynamicArray< std::unique_ptr< RunReader< Type > > > runs(count);
+  for (std::size_t run = 0; run < count; ++run) {
+    runs[run] =
+      std::make_unique< RunReader< Type > >(temp.path(first + run), blockSize);
+  }
+
+  RunWriter< Type > writer{ output, blockSize };
+
+  const auto before = [&runs, &compare](std::size_t left, std::size_t right) {
+    if (runs[left]->exhausted()) { return false; }
+    if (runs[right]->exhausted()) { return true; }
+
+    // Ties go to the earlier run
+    return left < right ? !compare(runs[right]->head(), runs[left]->head())
+                        : compare(runs[left]->head(), runs[right]->head());
+  };
+
+  merge::impl::LoserTree tree{ count, before };
+  while (!runs[tree.winner()]->exhausted()) {
+    auto& run = *runs[tree.winner()];
+
+    writer.push(run.head());
+    run.advance();
+    tree.replay();
+  }
+
+  writer.finish();
+}
+
+/**
+ * @brief Sort chunks of the input into run files.
+ * @headerfile aizo_sort_external_impl.hpp
+ *
+ * @tparam Type Type of the values.
+ * @tparam Compare Comparison function type.
+ * @param input File to read.
+ * @param temp Temporary files to write the runs to.
+ * @param chunkSize Number of values per run.
+ * @param compare Comparison function.
+ * @return Number of runs, their indices start at 0.
+ *
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Three chunk buffers rotate: while one chunk is sorted with
+ * quick::pdq, the next one is read by a background task and the previous
+ * one is written by another.
+ */
+template< typename Type, typename Compare >
+std::size_t generateRuns(InputFile< Type >& input,
+                         TempFiles&         temp,
+                         std::size_t        chunkSize,
+                         Compare            compare) {
+  std::array< ds::DynamicArray< Type >, 3 > buffers{};
+  for (auto& buffer : buffers) { buffer = ds::DynamicArray< Type >(chunkSize); }
+
+  const auto read = [&input, &buffers, chunkSize](std::size_t buffer) {
+    return input.read(buffers[buffer].data(), chunkSize);
+  };
+
+  std::size_t filling = 0;
+  auto        reading = std::async(std::launch::async, read, filling);
+  std::future< void > writing{};
+
+  std::size_t runs = 0;
+  while (true) {
+    const auto count = reading.get();
+    if (count == 0) { break; }
+
+    const auto sorting = filling;
+    filling            = (filling + 1) % buffers.size();
+    reading            = std::async(std::launch::async, read, filling);
+
+    const auto data = buffers[sorting].data();
+    quick::pdq(data, data + count, compare);
+
+    if (writing.valid()) { writing.get(); }
+    writing = std::async(
+      std::launch::async, [path = temp.path(temp.next()), data, count] {
+        OutputFile< Type > file{ path, false, count };
+        file.write(data, count);
+        file.close();
+      });
+
+    ++runs;
+  }
+
+  if (writing.valid()) { writing.get(); }
+  return runs;
+}
+
+} // namespace aizo::sort::external::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_EXTERNAL_IMPL_HPP
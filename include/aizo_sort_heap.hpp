@@ -1,7 +1,9 @@
 #ifndef UNI_AIZO_P_AIZO_SORT_HEAP_HPP
 #define UNI_AIZO_P_AIZO_SORT_HEAP_HPP
 
+#include "aizo_ds_dynamicarray.hpp"
 #include "aizo_sort_heap_impl.hpp"
+#include "aizo_sort_network.hpp"
 
 /**
  * @brief Heap sort algorithms.
@@ -14,6 +16,8 @@ namespace aizo::sort::heap {
  * @note Time complexity: O(n log n).
  * @headerfile aizo_sort_heap.hpp
  *
+ * @tparam NetworkSize Once the heap shrinks to this size it is sorted with a
+ * sorting network, 0 to keep extracting down to the last element.
  * @tparam Itr Iterator type.
  * @tparam Compare Comparison function type.
  * @param begin Iterator to the beginning of the range.
@@ -24,7 +28,68 @@ namespace aizo::sort::heap {
  * @attention Requires Compare to be a function object that returns a boolean.
  *
  * @details Repeatedly Builds a heap with the given compare function each time
- * with a smaller range.
+ * with a smaller range. With a NetworkSize the last NetworkSize elements are
+ * sorted by network::bounded instead of being extracted one by one.
+ */
+template< std::size_t NetworkSize = 0,
+          typename Itr,
+          typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool > &&
+         (NetworkSize == 0 || NetworkSize >= 2)
+constexpr void classic(Itr begin, Itr end, Compare compare = Compare{}) {
+  if constexpr (NetworkSize != 0) {
+    const auto networkSize = static_cast< std::ptrdiff_t >(NetworkSize);
+
+    if (std::distance(begin, end) > networkSize) {
+      impl::buildHeap(begin, end, compare);
+
+      // Extract the maxima until the rest of the heap fits the network
+      while (std::distance(begin, end) > networkSize) {
+        end = std::prev(end);
+        std::iter_swap(begin, end);
+
+        impl::heapify(begin, end, compare);
+      }
+    }
+
+    network::bounded< NetworkSize >(begin, end, compare);
+  } else {
+    impl::buildHeap(begin, end, compare);
+
+    for (auto current = std::prev(end); current != begin;
+         current      = std::prev(current)) {
+      std::iter_swap(begin, current);
+
+      impl::heapify(begin, current, compare);
+    }
+
+    std::iter_swap(begin, std::next(begin));
+  }
+}
+
+/**
+ * @brief Bottom-up heap sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n).
+ * @headerfile aizo_sort_heap.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Builds the heap in linear time with Floyd's method. Each extracted
+ * maximum leaves a hole at the root, the last element of the heap is sifted
+ * into it with a leaf search. About half of the comparisons of classic and
+ * elements are moved instead of swapped.
  */
 template< typename Itr, typename Compare = std::less<> >
 requires std::random_access_iterator< Itr > &&
@@ -32,17 +97,157 @@ requires std::random_access_iterator< Itr > &&
                                                std::iter_value_t< Itr >,
                                                std::iter_value_t< Itr > >,
                          bool >
-constexpr void classic(Itr begin, Itr end, Compare compare = Compare{}) {
-  impl::buildHeap(begin, end, compare);
+constexpr void bottomUp(Itr begin, Itr end, Compare compare = Compare{}) {
+  impl::floydHeap(begin, end, compare);
+  impl::sortHeap(begin, end, compare);
+}
+
+/**
+ * @brief D-ary heap sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n).
+ * @headerfile aizo_sort_heap.hpp
+ *
+ * @tparam Arity Number of children of a node, typically 4, 8 or 16.
+ * @tparam Prefetch Whether to prefetch the grandchildren while sifting, off by
+ * default since hardware prefetchers usually keep up.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Bottom-up heap sort on a heap where every node has Arity children
+ * stored next to each other. With Arity * sizeof(value) up to a cache line,
+ * the children of a node take one or two lines instead of one line per level
+ * of a binary heap, which pays off once the range outgrows the cache. More
+ * comparisons than bottomUp, so prefer it for cheap keys.
+ */
+template< std::size_t Arity    = 8,
+          bool        Prefetch = false,
+          typename Itr,
+          typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool > &&
+         (Arity >= 2)
+constexpr void dary(Itr begin, Itr end, Compare compare = Compare{}) {
+  impl::floydHeap< Arity, Prefetch >(begin, end, compare);
+
+  for (auto last = std::distance(begin, end) - 1; last > 0; --last) {
+    auto value              = std::move(*std::next(begin, last));
+    *std::next(begin, last) = std::move(*begin);
+    impl::siftHoleDary< Arity, Prefetch >(
+      begin, last, 0, std::move(value), compare);
+  }
+}
+
+/**
+ * @brief Partial heap sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log k), k = middle - begin.
+ * @headerfile aizo_sort_heap.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param middle Iterator to the end of the part to sort.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Puts the k smallest elements of the range in order into [begin,
+ * middle), the rest ends up in [middle, end) in unspecified order. Keeps the
+ * k smallest elements seen so far in a bounded max-heap in [begin, middle).
+ * An element smaller than the top replaces it and is sifted into place, other
+ * elements cost a single comparison. Finally the heap is sorted.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void partial(Itr     begin,
+                       Itr     middle,
+                       Itr     end,
+                       Compare compare = Compare{}) {
+  if (begin == middle) { return; }
+
+  const auto size = std::distance(begin, middle);
+  impl::floydHeap(begin, middle, compare);
+
+  for (auto current = middle; current != end; current = std::next(current)) {
+    if (compare(*current, *begin)) {
+      auto value = std::move(*current);
+      *current   = std::move(*begin);
+      impl::siftHole(begin, size, 0, std::move(value), compare);
+    }
+  }
+
+  impl::sortHeap(begin, middle, compare);
+}
+
+/**
+ * @brief Get the k smallest elements of a range in order.
+ * @category Sort
+ * @note Time complexity: O(n log k).
+ * @headerfile aizo_sort_heap.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param count Number of elements to get, k.
+ * @param compare Comparison function, std::greater to get the largest ones.
+ * @return Sorted array of the min(k, n) smallest elements.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ * @attention Requires the element type to be default constructible and
+ * copyable.
+ *
+ * @details Same bounded heap as partial(), but the heap lives in the
+ * returned DynamicArray and the range is left untouched. Only k elements of
+ * memory are needed.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr ds::DynamicArray< std::iter_value_t< Itr > >
+topK(Itr begin, Itr end, std::size_t count, Compare compare = Compare{}) {
+  const auto size = std::min(static_cast< std::ptrdiff_t >(count),
+                             std::distance(begin, end));
+
+  ds::DynamicArray< std::iter_value_t< Itr > > result(
+    static_cast< std::size_t >(size));
+  if (size == 0) { return result; }
 
-  for (auto current = std::prev(end); current != begin;
-       current      = std::prev(current)) {
-    std::iter_swap(begin, current);
+  const auto heap   = std::begin(result);
+  const auto middle = std::next(begin, size);
+  std::copy(begin, middle, heap);
+  impl::floydHeap(heap, std::end(result), compare);
 
-    impl::heapify(begin, current, compare);
+  for (auto current = middle; current != end; current = std::next(current)) {
+    if (compare(*current, *heap)) {
+      auto value = *current;
+      impl::siftHole(heap, size, 0, std::move(value), compare);
+    }
   }
 
-  std::iter_swap(begin, std::next(begin));
+  impl::sortHeap(heap, std::end(result), compare);
+  return result;
 }
 
 } // namespace aizo::sort::heap
@@ -1,6 +1,13 @@
 #ifndef UNI_AIZO_P_AIZO_SORT_HEAP_IMPL_HPP
 #define UNI_AIZO_P_AIZO_SORT_HEAP_IMPL_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
 /**
  * @brief Implementation specific functionality for heap sortFunction
  * algorithms.
@@ -99,6 +106,266 @@ constexpr void heapify(Itr begin, Itr end, Compare compare = Compare{}) {
   }
 }
 
+/**
+ * @brief Sift a value down from a hole with a leaf search.
+ * @headerfile aizo_sort_heap_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the heap.
+ * @param size Size of the heap.
+ * @param hole Index of the hole the value belongs to.
+ * @param value Value to place, moved out of the hole.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Walks the hole down to a leaf along the larger children, one
+ * comparison per level, moving every child up instead of swapping. Then climbs
+ * back from the leaf until the parent is not smaller than the value. The value
+ * almost always belongs near the bottom, so the climb is short.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void siftHole(Itr                        begin,
+                        std::ptrdiff_t             size,
+                        std::ptrdiff_t             hole,
+                        std::iter_value_t< Itr >&& value,
+                        Compare                    compare) {
+  const auto top   = hole;
+  auto       child = 2 * hole + 2;
+
+  // Leaf search, the hole follows the larger child
+  while (child < size) {
+    if (compare(*std::next(begin, child), *std::next(begin, child - 1))) {
+      --child;
+    }
+
+    *std::next(begin, hole) = std::move(*std::next(begin, child));
+    hole                    = child;
+    child                   = 2 * hole + 2;
+  }
+  if (child == size) {
+    *std::next(begin, hole) = std::move(*std::next(begin, child - 1));
+    hole                    = child - 1;
+  }
+
+  // Climb back, the hole follows the smaller parents
+  auto parent = (hole - 1) / 2;
+  while (hole > top && compare(*std::next(begin, parent), value)) {
+    *std::next(begin, hole) = std::move(*std::next(begin, parent));
+    hole                    = parent;
+    parent                  = (hole - 1) / 2;
+  }
+
+  *std::next(begin, hole) = std::move(value);
+}
+
+/**
+ * @brief Assumed size of a cache line in bytes.
+ */
+inline constexpr std::ptrdiff_t cacheLine = 64;
+
+/**
+ * @brief Prefetch the children of the children of a node.
+ * @headerfile aizo_sort_heap_impl.hpp
+ *
+ * @tparam Arity Number of children of a node.
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the heap.
+ * @param size Size of the heap.
+ * @param firstChild Index of the first child of the node.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ *
+ * @details Only a hint, does nothing for iterators that are not contiguous,
+ * during constant evaluation and on compilers without a prefetch builtin.
+ * Touches every cache line of the grandchildren, which for small keys are a
+ * few neighbouring lines.
+ */
+template< std::size_t Arity, typename Itr >
+requires std::random_access_iterator< Itr >
+constexpr void
+prefetchGrandchildren([[maybe_unused]] Itr            begin,
+                      [[maybe_unused]] std::ptrdiff_t size,
+                      [[maybe_unused]] std::ptrdiff_t firstChild) {
+#if defined(__GNUC__)
+  if constexpr (std::contiguous_iterator< Itr >) {
+    if (std::is_constant_evaluated()) { return; }
+
+    constexpr auto arity = static_cast< std::ptrdiff_t >(Arity);
+    constexpr auto step  = std::max< std::ptrdiff_t >(
+      cacheLine / static_cast< std::ptrdiff_t >(sizeof(*begin)), 1);
+
+    const auto first = arity * firstChild + 1;
+    const auto last  = std::min(arity * (firstChild + arity) + 1, size);
+
+    for (auto index = first; index < last; index += step) {
+      __builtin_prefetch(std::to_address(std::next(begin, index)));
+    }
+  }
+#endif
+}
+
+/**
+ * @brief Sift a value down from a hole of a d-ary heap with a leaf search.
+ * @headerfile aizo_sort_heap_impl.hpp
+ *
+ * @tparam Arity Number of children of a node.
+ * @tparam Prefetch Whether to prefetch the grandchildren on the way down.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the heap.
+ * @param size Size of the heap.
+ * @param hole Index of the hole the value belongs to.
+ * @param value Value to place, moved out of the hole.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Same as siftHole with Arity children per node, stored next to each
+ * other at Arity * node + 1. The heap is log(Arity) times shallower, so there
+ * are fewer levels to miss the cache on, and the children of a node are read
+ * as one block.
+ */
+template< std::size_t Arity, bool Prefetch, typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void siftHoleDary(Itr                        begin,
+                            std::ptrdiff_t             size,
+                            std::ptrdiff_t             hole,
+                            std::iter_value_t< Itr >&& value,
+                            Compare                    compare) {
+  constexpr auto arity = static_cast< std::ptrdiff_t >(Arity);
+
+  const auto top   = hole;
+  auto       first = arity * hole + 1;
+
+  // Leaf search, the hole follows the largest child
+  while (first < size) {
+    if constexpr (Prefetch) {
+      prefetchGrandchildren< Arity >(begin, size, first);
+    }
+
+    const auto last = std::min(first + arity, size);
+    auto       best = first;
+    if constexpr (std::is_arithmetic_v< std::iter_value_t< Itr > >) {
+      // Keep the largest key in a register so the selection needs no branch
+      auto largest = *std::next(begin, first);
+      for (auto child = first + 1; child < last; ++child) {
+        const auto key    = *std::next(begin, child);
+        const bool larger = compare(largest, key);
+        best              = larger ? child : best;
+        largest           = larger ? key : largest;
+      }
+    } else {
+      for (auto child = first + 1; child < last; ++child) {
+        if (compare(*std::next(begin, best), *std::next(begin, child))) {
+          best = child;
+        }
+      }
+    }
+
+    *std::next(begin, hole) = std::move(*std::next(begin, best));
+    hole                    = best;
+    first                   = arity * hole + 1;
+  }
+
+  // Climb back, the hole follows the smaller parents
+  auto parent = (hole - 1) / arity;
+  while (hole > top && compare(*std::next(begin, parent), value)) {
+    *std::next(begin, hole) = std::move(*std::next(begin, parent));
+    hole                    = parent;
+    parent                  = (hole - 1) / arity;
+  }
+
+  *std::next(begin, hole) = std::move(value);
+}
+
+/**
+ * @brief Floyd heap construction.
+ * @headerfile aizo_sort_heap_impl.hpp
+ *
+ * @tparam Arity Number of children of a node.
+ * @tparam Prefetch Whether to prefetch grandchildren, only for Arity above 2.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Sifts down every inner node, from the last one to the root. Most
+ * nodes sit near the bottom and move little, which makes the construction
+ * linear.
+ */
+template< std::size_t Arity    = 2,
+          bool        Prefetch = false,
+          typename Itr,
+          typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void floydHeap(Itr begin, Itr end, Compare compare) {
+  constexpr auto arity = static_cast< std::ptrdiff_t >(Arity);
+  const auto     size  = std::distance(begin, end);
+
+  for (auto node = (size - 2) / arity; node >= 0 && size > 1; --node) {
+    auto value = std::move(*std::next(begin, node));
+
+    if constexpr (Arity == 2) {
+      siftHole(begin, size, node, std::move(value), compare);
+    } else {
+      siftHoleDary< Arity, Prefetch >(
+        begin, size, node, std::move(value), compare);
+    }
+  }
+}
+
+/**
+ * @brief Sort a heap by extracting the maxima.
+ * @headerfile aizo_sort_heap_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the heap.
+ * @param end Iterator to the end of the heap.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ * @attention Requires the range to be a binary heap.
+ *
+ * @details Every maximum is moved behind the shrinking heap and the last
+ * element of the heap is sifted into the hole it leaves at the root.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void sortHeap(Itr begin, Itr end, Compare compare) {
+  for (auto last = std::distance(begin, end) - 1; last > 0; --last) {
+    auto value              = std::move(*std::next(begin, last));
+    *std::next(begin, last) = std::move(*begin);
+    siftHole(begin, last, 0, std::move(value), compare);
+  }
+}
+
 } // namespace aizo::sort::heap::impl
 
 #endif // UNI_AIZO_P_AIZO_SORT_HEAP_IMPL_HPP
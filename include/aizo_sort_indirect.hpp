@@ -0,0 +1,247 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_INDIRECT_HPP
+#define UNI_AIZO_P_AIZO_SORT_INDIRECT_HPP
+
+#include "aizo_ds_dynamicarray.hpp"
+#include "aizo_sort_indirect_impl.hpp"
+#include "aizo_sort_merge.hpp"
+#include <concepts>
+#include <cstdint>
+
+namespace aizo::sort {
+
+/**
+ * @brief Indirect sort, get the permutation that sorts a range.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n) for ranges made of few runs.
+ * @headerfile aizo_sort_indirect.hpp
+ *
+ * @tparam Index Index type of the permutation.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Indices of the elements in sorted order.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ * @attention Requires the size of the range to be representable by Index.
+ *
+ * @details Element i of the result is the position in the range of the
+ * element that belongs at i, so iterating the range through it visits the
+ * elements in sorted order. The range is not modified: the indices are sorted
+ * with merge::tim, comparing the elements they point to. Only indices move,
+ * which pays off for large elements, and the merges need fewer of the
+ * indirect comparisons than a quick sort would. Stable, equal elements keep
+ * their order in the permutation. See applyPermutation to reorder the range
+ * afterwards.
+ */
+template< std::unsigned_integral Index = std::uint32_t,
+          typename Itr,
+          typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr ds::DynamicArray< Index > argsort(
+  Itr begin, Itr end, Compare compare = Compare{}) {
+  const auto size = static_cast< std::size_t >(std::distance(begin, end));
+
+  ds::DynamicArray< Index > indices(size);
+  for (std::size_t index = 0; index < size; ++index) {
+    indices[index] = static_cast< Index >(index);
+  }
+
+  merge::tim(std::begin(indices),
+             std::end(indices),
+             [begin, &compare](Index first, Index second) -> bool {
+               return compare(*std::next(begin, first),
+                              *std::next(begin, second));
+             });
+
+  return indices;
+}
+
+/**
+ * @brief Reorder a range by a permutation in place.
+ * @category Sort
+ * @note Time complexity: O(n).
+ * @headerfile aizo_sort_indirect.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam IndexItr Iterator type of the permutation.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param indices Iterator to the beginning of the permutation.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires IndexItr to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires the permutation to hold every position of the range
+ * exactly once.
+ *
+ * @details Afterwards element i is the element that was at indices[i], so
+ * the permutation from argsort sorts the range. Follows the cycles of the
+ * permutation, every element is moved once plus once per cycle, no element
+ * is copied. The permutation itself is left unchanged, the visited positions
+ * are tracked in a separate array of flags.
+ */
+template< typename Itr, typename IndexItr >
+requires std::random_access_iterator< Itr > &&
+         std::random_access_iterator< IndexItr > &&
+         std::integral< std::iter_value_t< IndexItr > >
+constexpr void applyPermutation(Itr begin, Itr end, IndexItr indices) {
+  const auto size = std::distance(begin, end);
+
+  ds::DynamicArray< bool > visited(static_cast< std::size_t >(size), false);
+
+  for (std::ptrdiff_t start = 0; start < size; ++start) {
+    if (visited[start]) { continue; }
+
+    impl::applyCycle(begin, indices, std::begin(visited), start);
+  }
+}
+
+/**
+ * @brief Sort parallel arrays by the keys in one of them.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n) for ranges made of few runs.
+ * @headerfile aizo_sort_indirect.hpp
+ *
+ * @tparam Compare Comparison function type of the keys.
+ * @tparam KeyItr Iterator type of the keys.
+ * @tparam PayloadItr Iterator types of the payload columns.
+ * @param keysBegin Iterator to the beginning of the keys.
+ * @param keysEnd Iterator to the end of the keys.
+ * @param payloads Iterators to the beginnings of the payload columns.
+ *
+ * @attention Requires KeyItr and every PayloadItr to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a default constructible function object
+ * that returns a boolean.
+ * @attention Requires the key type to be default constructible and fewer than
+ * 2^32 keys.
+ * @attention Requires every payload column to hold at least as many elements
+ * as there are keys.
+ *
+ * @details Struct-of-arrays counterpart of sorting records by a key member.
+ * The keys are paired with their positions in a dense side array and sorted
+ * there, comparisons never touch the payload columns. The sorted keys are
+ * moved back and every payload column is reordered once by the resulting
+ * permutation with applyPermutation. Stable.
+ */
+template< typename Compare = std::less<>,
+          typename KeyItr,
+          typename... PayloadItr >
+requires std::random_access_iterator< KeyItr > &&
+         (std::random_access_iterator< PayloadItr > && ...) &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< KeyItr >,
+                                               std::iter_value_t< KeyItr > >,
+                         bool >
+constexpr void byKey(KeyItr keysBegin, KeyItr keysEnd, PayloadItr... payloads) {
+  using Key = std::iter_value_t< KeyItr >;
+
+  const auto size =
+    static_cast< std::size_t >(std::distance(keysBegin, keysEnd));
+
+  ds::DynamicArray< impl::Keyed< Key > > keyed(size);
+  for (std::size_t index = 0; index < size; ++index) {
+    keyed[index] = { std::move(*std::next(keysBegin, index)),
+                     static_cast< std::uint32_t >(index) };
+  }
+
+  const auto indices = impl::sortKeyed(keyed, Compare{});
+
+  for (std::size_t index = 0; index < size; ++index) {
+    *std::next(keysBegin, index) = std::move(keyed[index].key);
+  }
+
+  (applyPermutation(payloads,
+                    std::next(payloads, std::distance(keysBegin, keysEnd)),
+                    std::begin(indices)),
+   ...);
+}
+
+/**
+ * @brief Compare elements by a projection of them.
+ * @headerfile aizo_sort_indirect.hpp
+ *
+ * @tparam Projection Projection function type.
+ * @tparam Compare Comparison function type of the projected keys.
+ * @param projection Projection function or member pointer.
+ * @param compare Comparison function of the projected keys.
+ * @return Comparison function of the elements.
+ *
+ * @attention Nodiscard.
+ *
+ * @details Ranges style projections for every engine: the result can be
+ * passed as the Compare of any sort, for example
+ * quick::pdq(begin, end, projected(&Record::key)). Elements are passed by
+ * reference and only the keys are compared, the projection runs twice per
+ * comparison. Engines specialized for the standard comparators (radix, the
+ * vector partitions) take their generic path. Use cachedKey when the
+ * projection is costly.
+ */
+template< typename Projection, typename Compare = std::less<> >
+[[nodiscard]] constexpr impl::ProjectedCompare< Projection, Compare > projected(
+  Projection projection, Compare compare = Compare{}) {
+  return { std::move(projection), std::move(compare) };
+}
+
+/**
+ * @brief Sort by keys computed once per element (Schwartzian transform).
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n) projections.
+ * @headerfile aizo_sort_indirect.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Projection Projection function type.
+ * @tparam Compare Comparison function type of the projected keys.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param projection Projection function or member pointer.
+ * @param compare Comparison function of the projected keys.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean
+ * for two projected keys.
+ * @attention Requires the projected key type to be default constructible and
+ * fewer than 2^32 elements.
+ *
+ * @details Projects every element exactly once into a dense side array of
+ * keys paired with their positions, sorts the pairs by key and reorders the
+ * range once with applyPermutation. Pays off when projecting costs more than
+ * the extra pass, e.g. parsing or normalizing strings. Stable.
+ */
+template< typename Itr, typename Projection, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::invocable< Projection&, std::iter_reference_t< Itr > > &&
+         std::is_same_v< std::invoke_result_t<
+                           Compare,
+                           impl::ProjectedKey< Projection, Itr >,
+                           impl::ProjectedKey< Projection, Itr > >,
+                         bool >
+constexpr void cachedKey(Itr        begin,
+                         Itr        end,
+                         Projection projection,
+                         Compare    compare = Compare{}) {
+  using Key = impl::ProjectedKey< Projection, Itr >;
+
+  const auto size = static_cast< std::size_t >(std::distance(begin, end));
+
+  ds::DynamicArray< impl::Keyed< Key > > keyed(size);
+  for (std::size_t index = 0; index < size; ++index) {
+    keyed[index] = { std::invoke(projection, *std::next(begin, index)),
+                     static_cast< std::uint32_t >(index) };
+  }
+
+  const auto indices = impl::sortKeyed(keyed, compare);
+  applyPermutation(begin, end, std::begin(indices));
+}
+
+} // namespace aizo::sort
+
+#endif // UNI_AIZO_P_AIZO_SORT_INDIRECT_HPP
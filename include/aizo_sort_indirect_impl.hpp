@@ -0,0 +1,137 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_INDIRECT_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_INDIRECT_IMPL_HPP
+
+#include "aizo_ds_dynamicarray.hpp"
+#include "aizo_sort_merge.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Implementation specific functionality for indirect sorting.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::impl {
+
+/**
+ * @brief Apply one cycle of a permutation in place.
+ * @headerfile aizo_sort_indirect_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam IndexItr Iterator type of the permutation.
+ * @tparam VisitedItr Iterator type of the visited flags.
+ * @param begin Iterator to the beginning of the range.
+ * @param indices Iterator to the beginning of the permutation.
+ * @param visited Iterator to the beginning of the visited flags.
+ * @param start Position the cycle starts at.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires IndexItr to be at least of category
+ * RandomAccessIterator.
+ *
+ * @details Moves the element at start out, pulls every element of the cycle
+ * from the position the permutation names into the hole and moves the first
+ * element into the last hole. One move per element plus one for the cycle,
+ * every position of the cycle is flagged as visited.
+ */
+template< typename Itr, typename IndexItr, typename VisitedItr >
+requires std::random_access_iterator< Itr > &&
+         std::random_access_iterator< IndexItr >
+constexpr void applyCycle(Itr            begin,
+                          IndexItr       indices,
+                          VisitedItr     visited,
+                          std::ptrdiff_t start) {
+  auto value = std::move(*std::next(begin, start));
+  auto hole  = start;
+
+  while (true) {
+    *std::next(visited, hole) = true;
+
+    const auto source =
+      static_cast< std::ptrdiff_t >(*std::next(indices, hole));
+    if (source == start) { break; }
+
+    *std::next(begin, hole) = std::move(*std::next(begin, source));
+    hole                    = source;
+  }
+
+  *std::next(begin, hole) = std::move(value);
+}
+
+/**
+ * @brief Comparison of the projections of two elements.
+ *
+ * @details Function object returned by aizo::sort::projected. The projection
+ * is applied with std::invoke, so member pointers work as well.
+ */
+template< typename Projection, typename Compare >
+struct ProjectedCompare {
+  Projection projection;
+  Compare    compare;
+
+  template< typename Left, typename Right >
+  [[nodiscard]] constexpr bool operator()(Left&& left, Right&& right) const {
+    return std::invoke(compare,
+                       std::invoke(projection, std::forward< Left >(left)),
+                       std::invoke(projection, std::forward< Right >(right)));
+  }
+};
+
+/**
+ * @brief Key type a projection yields for the elements of Itr.
+ */
+template< typename Projection, typename Itr >
+using ProjectedKey = std::remove_cvref_t<
+  std::invoke_result_t< Projection&, std::iter_reference_t< Itr > > >;
+
+/**
+ * @brief Key paired with the position of its element.
+ */
+template< typename Key >
+struct Keyed {
+  Key           key;
+  std::uint32_t index;
+};
+
+/**
+ * @brief Sort keys paired with their positions and get the permutation.
+ * @headerfile aizo_sort_indirect_impl.hpp
+ *
+ * @tparam Key Key type.
+ * @tparam Compare Comparison function type.
+ * @param keyed Keys paired with the positions of their elements.
+ * @param compare Comparison function of the keys.
+ * @return Positions in sorted order, a permutation for applyPermutation.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details The pairs are stored densely, so comparisons read only keys that
+ * are next to each other in memory, never the elements they belong to. Sorted
+ * with merge::tim on the keys alone, stable.
+ */
+template< typename Key, typename Compare >
+[[nodiscard]] constexpr ds::DynamicArray< std::uint32_t > sortKeyed(
+  ds::DynamicArray< Keyed< Key > >& keyed, Compare compare) {
+  merge::tim(std::begin(keyed),
+             std::end(keyed),
+             [&compare](const Keyed< Key >& first,
+                        const Keyed< Key >& second) -> bool {
+               return compare(first.key, second.key);
+             });
+
+  ds::DynamicArray< std::uint32_t > indices(keyed.size());
+  for (std::size_t index = 0; index < keyed.size(); ++index) {
+    indices[index] = keyed[index].index;
+  }
+
+  return indices;
+}
+
+} // namespace aizo::sort::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_INDIRECT_IMPL_HPP
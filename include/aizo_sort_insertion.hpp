@@ -48,7 +48,7 @@ constexpr void classic(Itr begin, Itr end, Compare compare = Compare{}) {
 /**
  * @brief Binary insertion sort algorithm.
  * @category Sort
- * @note Time complexity: O(n^2).
+ * @note Time complexity: O(n^2), O(n log n) comparisons.
  * @headerfile aizo_sort_insertion.hpp
  *
  * @tparam Itr Iterator type.
@@ -56,56 +56,36 @@ constexpr void classic(Itr begin, Itr end, Compare compare = Compare{}) {
  * @param begin Iterator to the beginning of the range.
  * @param end Iterator to the end of the range.
  * @param compare Comparison function.
- * @param equal Equality comparison function.
  *
  * @attention Requires Itr to be at least of category RandomAccessIterator.
  * @attention Requires Compare to be a function object that returns a boolean.
- * @attention Requires EqualityComparator to be a function object that returns a
- * boolean.
  *
- * @details Uses binary search to find the correct position for each element and
- * then shifts the elements to make space for the new element.
+ * @details Elements not smaller than their predecessor stay in place. Others
+ * are moved out, their position in the sorted prefix is found with a
+ * branchless binary search after the equal elements, which keeps the sort
+ * stable, and the elements in between are shifted by one in bulk.
  */
-template< typename Itr,
-          typename Compare            = std::less<>,
-          typename EqualityComparator = std::equal_to<> >
+template< typename Itr, typename Compare = std::less<> >
 requires std::random_access_iterator< Itr > &&
          std::is_same_v< std::invoke_result_t< Compare,
                                                std::iter_value_t< Itr >,
                                                std::iter_value_t< Itr > >,
-                         bool > &&
-         std::is_same_v< std::invoke_result_t< EqualityComparator,
-                                               std::iter_value_t< Itr >,
-                                               std::iter_value_t< Itr > >,
                          bool >
-constexpr void binary(Itr                begin,
-                      Itr                end,
-                      Compare            compare = Compare{},
-                      EqualityComparator equal   = EqualityComparator{}) {
+constexpr void binary(Itr begin, Itr end, Compare compare = Compare{}) {
+  if (begin == end) { return; }
+
   for (auto current = std::next(begin); current != end;
        current      = std::next(current)) {
-    auto       prev   = std::prev(current);
-    const auto target = *current;
-
-    auto pos = impl::bSearch(begin, prev, target, compare, equal);
+    if (!compare(*current, *std::prev(current))) { continue; }
 
-    // Make room for the target element.
-    while (prev > pos) {
-      *std::next(prev) = *prev;
-
-      prev = std::prev(prev);
-    }
-
-    if (prev < pos) {
-      *std::next(prev) = target;
-
-      continue;
-    }
+    auto target = std::move(*current);
 
-    *std::next(prev) = *prev;
+    // The predecessor is greater, so the search can skip it
+    const auto position =
+      impl::upperBound(begin, std::prev(current), target, compare);
 
-    // Insert the target element.
-    *prev = target;
+    impl::shiftRight(position, current);
+    *position = std::move(target);
   }
 }
 
@@ -1,8 +1,13 @@
 #ifndef UNI_AIZO_P_AIZO_SORT_INSERTION_IMPL_HPP
 #define UNI_AIZO_P_AIZO_SORT_INSERTION_IMPL_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <type_traits>
 
 /**
  * @brief Implementation specific functionality for insertion sort algorithms.
@@ -12,58 +17,80 @@
 namespace aizo::sort::insertion::impl {
 
 /**
- * @brief Binary search for insertion sort.
+ * @brief Branchless upper bound for insertion sort.
  * @headerfile aizo_sort_insertion_impl.hpp
  *
  * @tparam Itr Iterator type.
  * @tparam Compare Comparison function type.
- * @tparam EqualityComparator Equality comparison function type.
  * @param lower Iterator to the beginning of the range.
  * @param upper Iterator to the end of the range.
  * @param target Target element to find.
  * @param compare Comparison function.
- * @param equal Equality comparison function.
- * @return Iterator to the correct position.
+ * @return Iterator to the first element greater than the target.
  *
  * @attention Nodiscard.
  * @attention Requires Itr to be at least of category RandomAccessIterator.
  * @attention Requires Compare to be a function object that returns a boolean.
- * @attention Requires EqualityComparator to be a function object that returns a
- boolean.
+ * @attention Requires a sorted range.
  *
- * @details Uses binary search to find the correct position for current element
- in the range [lower, upper). Assumes that the range is sorted.
+ * @details Halves the range with one comparison per step and no branch on
+ * its result, the next base is selected with a conditional move. The number
+ * of steps depends only on the size of the range. Returning the position
+ * after the equal elements keeps insertion sort stable.
  */
-template< typename Itr, typename Compare, typename EqualityComparator >
+template< typename Itr, typename Compare >
 requires std::random_access_iterator< Itr > &&
          std::is_same_v< std::invoke_result_t< Compare,
                                                std::iter_value_t< Itr >,
                                                std::iter_value_t< Itr > >,
-                         bool > &&
-         std::is_same_v< std::invoke_result_t< EqualityComparator,
-                                               std::iter_value_t< Itr >,
-                                               std::iter_value_t< Itr > >,
                          bool >
-[[nodiscard]] constexpr Itr bSearch(Itr                             lower,
-                                    Itr                             upper,
-                                    const std::iter_value_t< Itr >& target,
-                                    Compare                         compare,
-                                    EqualityComparator              equal) {
-  while (upper > lower) {
-    auto mid = std::next(lower, (std::distance(lower, upper) + 1) / 2);
+[[nodiscard]] constexpr Itr upperBound(Itr                             lower,
+                                       Itr                             upper,
+                                       const std::iter_value_t< Itr >& target,
+                                       Compare compare) {
+  auto size = std::distance(lower, upper);
+  if (size == 0) { return lower; }
+
+  while (size > 1) {
+    const auto half = size / 2;
+    lower = compare(target, *std::next(lower, half)) ? lower
+                                                     : std::next(lower, half);
+    size -= half;
+  }
 
-    // Case found
-    if (equal(*mid, target)) { return std::next(mid); }
+  return compare(target, *lower) ? lower : std::next(lower);
+}
+
+/**
+ * @brief Shift a range one position forward.
+ * @headerfile aizo_sort_insertion_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @param first Iterator to the beginning of the range.
+ * @param last Iterator to the end of the range, its element is overwritten.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ *
+ * @details Trivially copyable elements in contiguous memory are shifted with
+ * a single memmove, other elements are moved one by one from the back.
+ */
+template< typename Itr >
+requires std::random_access_iterator< Itr >
+constexpr void shiftRight(Itr first, Itr last) {
+  using Type = std::iter_value_t< Itr >;
 
-    if (compare(*mid, target)) {
-      lower = std::next(mid);
-    } else {
-      upper = std::prev(mid);
+  if constexpr (std::contiguous_iterator< Itr > &&
+                std::is_trivially_copyable_v< Type >) {
+    if (!std::is_constant_evaluated()) {
+      const auto count = static_cast< std::size_t >(std::distance(first, last));
+      std::memmove(std::to_address(std::next(first)),
+                   std::to_address(first),
+                   count * sizeof(Type));
+      return;
     }
   }
 
-  // Case not found
-  return compare(*lower, target) ? std::next(lower) : lower;
+  std::move_backward(first, last, std::next(last));
 }
 
 } // namespace aizo::sort::insertion::impl
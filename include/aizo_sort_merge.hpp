@@ -0,0 +1,361 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_MERGE_HPP
+#define UNI_AIZO_P_AIZO_SORT_MERGE_HPP
+
+#include "aizo_sort_insertion.hpp"
+#include "aizo_sort_merge_impl.hpp"
+#include "aizo_sort_network.hpp"
+#include "aizo_tool_threadpool.hpp"
+#include <ranges>
+#include <thread>
+
+/**
+ * @brief Merge sort algorithms.
+ */
+namespace aizo::sort::merge {
+
+/**
+ * @brief Bottom-up merge sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n).
+ * @headerfile aizo_sort_merge.hpp
+ *
+ * @tparam NetworkSize Size of the blocks sorted with a sorting network before
+ * merging, 0 to sort impl::blockSize blocks with insertion sort.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ * @attention Requires the value type to be default constructible.
+ *
+ * @details Sorts small blocks, then merges neighbouring blocks of doubling
+ * width back and forth between the range and a buffer of the same size.
+ * Neighbours that are already in order are moved without merging. Stable
+ * unless a NetworkSize is given, sorting networks do not keep the order of
+ * equal elements.
+ */
+template< std::size_t NetworkSize = 0,
+          typename Itr,
+          typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool > &&
+         (NetworkSize == 0 || NetworkSize >= 2)
+constexpr void bottomUp(Itr begin, Itr end, Compare compare = Compare{}) {
+  const auto size = std::distance(begin, end);
+  if (size < 2) { return; }
+
+  const auto block = NetworkSize == 0
+                       ? impl::blockSize
+                       : static_cast< std::ptrdiff_t >(NetworkSize);
+
+  for (std::ptrdiff_t first = 0; first < size; first += block) {
+    const auto blockBegin = std::next(begin, first);
+    const auto blockEnd   = std::next(begin, std::min(first + block, size));
+
+    if constexpr (NetworkSize == 0) {
+      insertion::classic(blockBegin, blockEnd, compare);
+    } else {
+      network::bounded< NetworkSize >(blockBegin, blockEnd, compare);
+    }
+  }
+  if (size <= block) { return; }
+
+  ds::DynamicArray< std::iter_value_t< Itr > > buffer(
+    static_cast< std::size_t >(size));
+
+  // Every pass swaps the roles of the range and the buffer
+  bool inBuffer = false;
+  for (auto width = block; width < size; width *= 2) {
+    if (inBuffer) {
+      impl::mergePass(
+        std::begin(buffer), std::end(buffer), begin, width, compare);
+    } else {
+      impl::mergePass(begin, end, std::begin(buffer), width, compare);
+    }
+    inBuffer = !inBuffer;
+  }
+
+  if (inBuffer) { std::move(std::begin(buffer), std::end(buffer), begin); }
+}
+
+/**
+ * @brief TimSort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n) for ranges made of few runs.
+ * @headerfile aizo_sort_merge.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ * @attention Requires the value type to be default constructible.
+ *
+ * @details Stable. Detects the ascending and descending runs already present
+ * in the range, reverses the descending ones and merges neighbouring runs with
+ * galloping, so sorted, reversed and prefix sorted ranges take close to linear
+ * time. Short runs are extended with binary insertion sort. A single buffer of
+ * half the size of the range is allocated for all merges.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void tim(Itr begin, Itr end, Compare compare = Compare{}) {
+  impl::tim(begin, end, compare);
+}
+
+/**
+ * @brief Parallel stable merge sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n log n / threads) with enough cores.
+ * @headerfile aizo_sort_merge.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @param threads Number of threads to use, the calling thread included.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean
+ * and is safe to call concurrently.
+ * @attention Requires the element type to be default constructible, a
+ * scratch buffer of the size of the range is allocated.
+ *
+ * @details Stable, so the result does not depend on the number of threads.
+ * Every thread sorts one chunk with TimSort, using its slice of a single
+ * DynamicArray scratch buffer. Neighbouring runs are then merged pairwise,
+ * back and forth between the range and the buffer. Every merge is cut along
+ * the merge path into parts of equal output size, so all threads stay busy
+ * even in the last rounds with few long runs. Ranges of impl::parallelGrain
+ * elements or fewer are sorted sequentially.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+void parallel(Itr         begin,
+              Itr         end,
+              Compare     compare = Compare{},
+              std::size_t threads = std::thread::hardware_concurrency()) {
+  using Type = std::iter_value_t< Itr >;
+
+  const auto size = std::distance(begin, end);
+
+  if (threads <= 1 || size <= impl::parallelGrain) {
+    impl::tim(begin, end, compare);
+    return;
+  }
+
+  tool::ThreadPool pool{ threads - 1 };
+
+  ds::DynamicArray< Type > scratch(static_cast< std::size_t >(size));
+  const auto               buffer = std::begin(scratch);
+
+  // Sort one chunk per thread, run boundaries relative to the beginning
+  auto runs = static_cast< std::ptrdiff_t >(threads);
+  ds::DynamicArray< std::ptrdiff_t > bounds(threads + 1);
+  for (std::ptrdiff_t run = 0; run <= runs; ++run) {
+    bounds[run] = size * run / runs;
+  }
+  pool.forEach(threads, [&](std::size_t thread) {
+    const auto run = static_cast< std::ptrdiff_t >(thread);
+
+    impl::timBuffered(std::next(begin, bounds[run]),
+                      std::next(begin, bounds[run + 1]),
+                      std::next(buffer, bounds[run]),
+                      compare);
+  });
+
+  // Parts of every pair of runs, proportional to its size
+  ds::DynamicArray< std::ptrdiff_t > partBegin(threads + 1);
+
+  const auto round = [&](auto from, auto to) {
+    const auto pairs = (runs + 1) / 2;
+
+    partBegin[0] = 0;
+    for (std::ptrdiff_t pair = 0; pair < pairs; ++pair) {
+      const auto length =
+        bounds[std::min(2 * pair + 2, runs)] - bounds[2 * pair];
+      const auto parts =
+        (length * static_cast< std::ptrdiff_t >(threads) + size - 1) / size;
+
+      partBegin[pair + 1] = partBegin[pair] + parts;
+    }
+
+    const auto firstPart = std::begin(partBegin);
+    const auto lastPart  = std::next(firstPart, pairs + 1);
+
+    const auto tasks = static_cast< std::size_t >(partBegin[pairs]);
+    pool.forEach(tasks, [&](std::size_t task) {
+      const auto index = static_cast< std::ptrdiff_t >(task);
+      const auto pair  = std::distance(
+        firstPart, std::prev(std::upper_bound(firstPart, lastPart, index)));
+
+      impl::mergePart(std::next(from, bounds[2 * pair]),
+                      std::next(from, bounds[std::min(2 * pair + 1, runs)]),
+                      std::next(from, bounds[std::min(2 * pair + 2, runs)]),
+                      std::next(to, bounds[2 * pair]),
+                      index - partBegin[pair],
+                      partBegin[pair + 1] - partBegin[pair],
+                      compare);
+    });
+
+    // Every merged pair becomes a single run
+    for (std::ptrdiff_t pair = 0; pair <= pairs; ++pair) {
+      bounds[pair] = bounds[std::min(2 * pair, runs)];
+    }
+    runs = pairs;
+  };
+
+  bool inBuffer = false;
+  while (runs > 1) {
+    if (inBuffer) {
+      round(buffer, begin);
+    } else {
+      round(begin, buffer);
+    }
+    inBuffer = !inBuffer;
+  }
+
+  if (inBuffer) {
+    pool.forEach(threads, [&](std::size_t thread) {
+      const auto part = static_cast< std::ptrdiff_t >(thread);
+      const auto from = size * part / static_cast< std::ptrdiff_t >(threads);
+      const auto to =
+        size * (part + 1) / static_cast< std::ptrdiff_t >(threads);
+
+      std::move(
+        std::next(buffer, from), std::next(buffer, to), std::next(begin, from));
+    });
+  }
+}
+
+/**
+ * @brief K-way merge of sorted ranges.
+ * @category Sort
+ * @note Time complexity: O(n log k), O(n log k / threads) with enough cores.
+ * @headerfile aizo_sort_merge.hpp
+ *
+ * @tparam RangeItr Iterator type of the ranges.
+ * @tparam Out Destination iterator type.
+ * @tparam Compare Comparison function type.
+ * @param rangesBegin Iterator to the first sorted range.
+ * @param rangesEnd Iterator past the last sorted range.
+ * @param out Iterator to the beginning of the destination.
+ * @param compare Comparison function.
+ * @param threads Number of threads to use, the calling thread included.
+ * @return Iterator past the last merged element.
+ *
+ * @attention Requires RangeItr to be at least of category
+ * RandomAccessIterator and its elements to be random access ranges, e.g.
+ * DynamicArray.
+ * @attention Requires Out to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean
+ * and is safe to call concurrently.
+ * @attention Requires the destination not to overlap the ranges.
+ *
+ * @details Merges all k ranges into the destination in a single pass with a
+ * loser tree, about log2(k) comparisons per element instead of log2(k) passes
+ * over the data of pairwise merging. Exhausted ranges become sentinels that
+ * lose every match. Stable, equal elements are taken from earlier ranges
+ * first. The elements are copied, the ranges are left unchanged. With more
+ * than one thread the output is cut into parts of equal size and every
+ * range is cut at the matching split points, so every thread merges its
+ * part independently. Merges of impl::parallelGrain elements or fewer run
+ * sequentially.
+ */
+template< typename RangeItr, typename Out, typename Compare = std::less<> >
+requires std::random_access_iterator< RangeItr > &&
+         std::ranges::random_access_range<
+           std::iter_reference_t< RangeItr > > &&
+         std::random_access_iterator< Out > &&
+         std::is_same_v<
+           std::invoke_result_t<
+             Compare,
+             std::ranges::range_value_t< std::iter_reference_t< RangeItr > >,
+             std::ranges::range_value_t< std::iter_reference_t< RangeItr > > >,
+           bool >
+Out kway(RangeItr    rangesBegin,
+         RangeItr    rangesEnd,
+         Out         out,
+         Compare     compare = Compare{},
+         std::size_t threads = 1) {
+  using Source = std::ranges::iterator_t< std::iter_reference_t< RangeItr > >;
+
+  const auto count = static_cast< std::size_t >(
+    std::distance(rangesBegin, rangesEnd));
+
+  ds::DynamicArray< Source > begins(count);
+  ds::DynamicArray< Source > ends(count);
+  std::ptrdiff_t             size = 0;
+  for (std::size_t range = 0; range < count; ++range) {
+    auto&& current = *std::next(rangesBegin, range);
+
+    begins[range]  = std::ranges::begin(current);
+    ends[range]    = std::ranges::end(current);
+    size          += std::distance(begins[range], ends[range]);
+  }
+
+  if (threads <= 1 || size <= impl::parallelGrain) {
+    return impl::kwayMerge(begins, ends, out, compare);
+  }
+
+  tool::ThreadPool pool{ threads - 1 };
+
+  // Split points of part boundary p are at [p * count, (p + 1) * count)
+  const auto parts = static_cast< std::ptrdiff_t >(threads);
+  ds::DynamicArray< std::ptrdiff_t > splits((threads + 1) * count);
+  for (std::size_t range = 0; range < count; ++range) {
+    splits[range] = 0;
+    splits[threads * count + range] =
+      std::distance(begins[range], ends[range]);
+  }
+  pool.forEach(threads - 1, [&](std::size_t boundary) {
+    const auto part = static_cast< std::ptrdiff_t >(boundary) + 1;
+
+    impl::multiCoRank(
+      begins,
+      ends,
+      size * part / parts,
+      std::next(std::begin(splits),
+                part * static_cast< std::ptrdiff_t >(count)),
+      compare);
+  });
+
+  pool.forEach(threads, [&](std::size_t thread) {
+    const auto part = static_cast< std::ptrdiff_t >(thread);
+
+    ds::DynamicArray< Source > heads(count);
+    ds::DynamicArray< Source > partEnds(count);
+    for (std::size_t range = 0; range < count; ++range) {
+      heads[range] = std::next(begins[range], splits[thread * count + range]);
+      partEnds[range] =
+        std::next(begins[range], splits[(thread + 1) * count + range]);
+    }
+
+    impl::kwayMerge(
+      heads, partEnds, std::next(out, size * part / parts), compare);
+  });
+
+  return std::next(out, size);
+}
+
+} // namespace aizo::sort::merge
+
+#endif // UNI_AIZO_P_AIZO_SORT_MERGE_HPP
@@ -0,0 +1,935 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_MERGE_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_MERGE_IMPL_HPP
+
+#include "aizo_ds_dynamicarray.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Implementation specific functionality for merge sort algorithms.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::merge::impl {
+
+/**
+ * @brief Blocks of this size are sorted with insertion sort before merging.
+ */
+inline constexpr std::ptrdiff_t blockSize = 16;
+
+/**
+ * @brief Ranges shorter than this are sorted by TimSort as a single run.
+ */
+inline constexpr std::ptrdiff_t minMerge = 64;
+
+/**
+ * @brief Initial number of consecutive wins that switches a merge to
+ * galloping.
+ */
+inline constexpr std::ptrdiff_t minGallop = 7;
+
+/**
+ * @brief Upper bound of the number of pending runs, enough for any range that
+ * fits in memory given the run length invariants.
+ */
+inline constexpr std::size_t maxRuns = 85;
+
+/**
+ * @brief Ranges of this size or smaller are sorted sequentially.
+ */
+inline constexpr std::ptrdiff_t parallelGrain = 1 << 16;
+
+/**
+ * @brief Sorted run of a range, relative to its beginning.
+ */
+struct Run {
+  std::ptrdiff_t begin;
+  std::ptrdiff_t size;
+};
+
+/**
+ * @brief Merge two adjacent sorted ranges into a destination.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam From Source iterator type.
+ * @tparam To Destination iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the first range.
+ * @param middle Iterator to the end of the first and beginning of the second
+ * range.
+ * @param end Iterator to the end of the second range.
+ * @param destination Iterator to the beginning of the destination.
+ * @param compare Comparison function.
+ *
+ * @attention Requires From and To to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Stable. Ranges that are already in order are moved without
+ * comparing their elements.
+ */
+template< typename From, typename To, typename Compare >
+requires std::random_access_iterator< From > &&
+         std::random_access_iterator< To >
+constexpr void mergeInto(
+  From begin, From middle, From end, To destination, Compare compare) {
+  if (begin == middle || middle == end ||
+      !compare(*middle, *std::prev(middle))) {
+    std::move(begin, end, destination);
+    return;
+  }
+
+  std::merge(std::make_move_iterator(begin),
+             std::make_move_iterator(middle),
+             std::make_move_iterator(middle),
+             std::make_move_iterator(end),
+             destination,
+             compare);
+}
+
+/**
+ * @brief Merge neighbouring blocks of a given width from source to
+ * destination.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam From Source iterator type.
+ * @tparam To Destination iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the source.
+ * @param end Iterator to the end of the source.
+ * @param destination Iterator to the beginning of the destination.
+ * @param width Width of the sorted blocks.
+ * @param compare Comparison function.
+ *
+ * @attention Requires From and To to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ */
+template< typename From, typename To, typename Compare >
+requires std::random_access_iterator< From > &&
+         std::random_access_iterator< To >
+constexpr void mergePass(From           begin,
+                         From           end,
+                         To             destination,
+                         std::ptrdiff_t width,
+                         Compare        compare) {
+  const auto size = std::distance(begin, end);
+
+  for (std::ptrdiff_t first = 0; first < size; first += 2 * width) {
+    const auto middle = std::min(first + width, size);
+    const auto last   = std::min(first + 2 * width, size);
+
+    mergeInto(std::next(begin, first),
+              std::next(begin, middle),
+              std::next(begin, last),
+              std::next(destination, first),
+              compare);
+  }
+}
+
+/**
+ * @brief Find the end of the run at the beginning of a range.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Iterator to the end of the run.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires a non-empty range.
+ *
+ * @details A run is either non-descending or strictly descending. Strictly
+ * descending runs are reversed in place, which keeps the sort stable.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr >
+[[nodiscard]] constexpr Itr countRun(Itr begin, Itr end, Compare compare) {
+  auto runEnd = std::next(begin);
+  if (runEnd == end) { return runEnd; }
+
+  if (compare(*runEnd, *begin)) {
+    do {
+      runEnd = std::next(runEnd);
+    } while (runEnd != end && compare(*runEnd, *std::prev(runEnd)));
+
+    std::reverse(begin, runEnd);
+  } else {
+    do {
+      runEnd = std::next(runEnd);
+    } while (runEnd != end && !compare(*runEnd, *std::prev(runEnd)));
+  }
+
+  return runEnd;
+}
+
+/**
+ * @brief Extend a sorted prefix with stable binary insertion.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param sorted Iterator to the end of the sorted prefix.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Every element is inserted after the equal elements already placed.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr >
+constexpr void insertionExtend(Itr     begin,
+                               Itr     sorted,
+                               Itr     end,
+                               Compare compare) {
+  for (; sorted != end; sorted = std::next(sorted)) {
+    const auto position = std::upper_bound(begin, sorted, *sorted, compare);
+
+    if (position != sorted) {
+      auto value = std::move(*sorted);
+      std::move_backward(position, sorted, std::next(sorted));
+      *position = std::move(value);
+    }
+  }
+}
+
+/**
+ * @brief Minimal run length for TimSort.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @param size Size of the range.
+ * @return Run length between minMerge / 2 and minMerge.
+ *
+ * @attention Nodiscard.
+ *
+ * @details Chosen so that size / result is a power of two or slightly less,
+ * which keeps the final merges balanced.
+ */
+[[nodiscard]] constexpr std::ptrdiff_t minRunLength(std::ptrdiff_t size) {
+  std::ptrdiff_t lowBits = 0;
+
+  while (size >= minMerge) {
+    lowBits |= size & 1;
+    size >>= 1;
+  }
+
+  return size + lowBits;
+}
+
+/**
+ * @brief Find the first element greater than a key, searching from the front.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Type Key type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the sorted range.
+ * @param end Iterator to the end of the sorted range.
+ * @param key Key.
+ * @param compare Comparison function.
+ * @return Iterator to the first element greater than the key.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ *
+ * @details Exponential search followed by binary search, O(log k) for an
+ * answer k elements from the front.
+ */
+template< typename Itr, typename Type, typename Compare >
+requires std::random_access_iterator< Itr >
+[[nodiscard]] constexpr Itr gallopUpper(Itr         begin,
+                                        Itr         end,
+                                        const Type& key,
+                                        Compare     compare) {
+  const auto     size = std::distance(begin, end);
+  std::ptrdiff_t low  = 0;
+  std::ptrdiff_t high = 1;
+
+  while (high < size && !compare(key, *std::next(begin, high - 1))) {
+    low  = high;
+    high = 2 * high + 1;
+  }
+
+  return std::upper_bound(std::next(begin, low),
+                          std::next(begin, std::min(high, size)),
+                          key,
+                          compare);
+}
+
+/**
+ * @brief Find the first element not less than a key, searching from the
+ * front.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Type Key type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the sorted range.
+ * @param end Iterator to the end of the sorted range.
+ * @param key Key.
+ * @param compare Comparison function.
+ * @return Iterator to the first element not less than the key.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ *
+ * @details Exponential search followed by binary search, O(log k) for an
+ * answer k elements from the front.
+ */
+template< typename Itr, typename Type, typename Compare >
+requires std::random_access_iterator< Itr >
+[[nodiscard]] constexpr Itr gallopLower(Itr         begin,
+                                        Itr         end,
+                                        const Type& key,
+                                        Compare     compare) {
+  const auto     size = std::distance(begin, end);
+  std::ptrdiff_t low  = 0;
+  std::ptrdiff_t high = 1;
+
+  while (high < size && compare(*std::next(begin, high - 1), key)) {
+    low  = high;
+    high = 2 * high + 1;
+  }
+
+  return std::lower_bound(std::next(begin, low),
+                          std::next(begin, std::min(high, size)),
+                          key,
+                          compare);
+}
+
+/**
+ * @brief Merge a buffered run with the run that follows the output.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Buffer Buffer iterator type.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param first Iterator to the beginning of the buffered first run.
+ * @param firstEnd Iterator to the end of the buffered first run.
+ * @param second Iterator to the beginning of the second run.
+ * @param secondEnd Iterator to the end of the second run.
+ * @param output Iterator to the beginning of the output, the original place
+ * of the first run, directly before the second run.
+ * @param compare Comparison function.
+ * @param gallop Wins needed to start galloping, adapted in place.
+ *
+ * @attention Requires Buffer and Itr to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Takes elements one at a time until one run wins gallop times in a
+ * row, then gallops: the elements of a run that go before the head of the
+ * other run are found by exponential search and moved as a block. Galloping
+ * that pays off makes it start sooner next time and vice versa. Equal
+ * elements are taken from the first run. Merging from the back is the same
+ * with reverse iterators and a reversed comparison.
+ */
+template< typename Buffer, typename Itr, typename Compare >
+requires std::random_access_iterator< Buffer > &&
+         std::random_access_iterator< Itr >
+constexpr void mergeLow(Buffer          first,
+                        Buffer          firstEnd,
+                        Itr             second,
+                        Itr             secondEnd,
+                        Itr             output,
+                        Compare         compare,
+                        std::ptrdiff_t& gallop) {
+  while (first != firstEnd && second != secondEnd) {
+    std::ptrdiff_t firstWins  = 0;
+    std::ptrdiff_t secondWins = 0;
+
+    // One element at a time while neither run keeps winning
+    while (first != firstEnd && second != secondEnd) {
+      const bool takeSecond = compare(*second, *first);
+
+      if (takeSecond) {
+        *output   = std::move(*second);
+        second    = std::next(second);
+        firstWins = 0;
+        ++secondWins;
+      } else {
+        *output    = std::move(*first);
+        first      = std::next(first);
+        secondWins = 0;
+        ++firstWins;
+      }
+      output = std::next(output);
+
+      if (firstWins >= gallop || secondWins >= gallop) { break; }
+    }
+
+    // Move whole blocks while the searches keep finding long ones
+    while (first != firstEnd && second != secondEnd) {
+      const auto firstStop = gallopUpper(first, firstEnd, *second, compare);
+      firstWins            = std::distance(first, firstStop);
+      output               = std::move(first, firstStop, output);
+      first                = firstStop;
+      if (first == firstEnd) { break; }
+
+      const auto secondStop = gallopLower(second, secondEnd, *first, compare);
+      secondWins            = std::distance(second, secondStop);
+      output                = std::move(second, secondStop, output);
+      second                = secondStop;
+
+      if (firstWins < minGallop && secondWins < minGallop) {
+        ++gallop;
+        break;
+      }
+      gallop = std::max< std::ptrdiff_t >(gallop - 1, 1);
+    }
+  }
+
+  // Whatever is left of the second run is in place already
+  std::move(first, firstEnd, output);
+}
+
+/**
+ * @brief Merge two adjacent runs through a scratch buffer.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Buffer Buffer iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the first run.
+ * @param middle Iterator to the beginning of the second run.
+ * @param end Iterator to the end of the second run.
+ * @param buffer Iterator to a buffer of at least half of the size of both
+ * runs.
+ * @param compare Comparison function.
+ * @param gallop Wins needed to start galloping, adapted in place.
+ *
+ * @attention Requires Itr and Buffer to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Elements of the first run that precede the second run and
+ * elements of the second run that follow the first run are already in place
+ * and are skipped by galloping. Only the shorter remaining run is buffered.
+ */
+template< typename Itr, typename Buffer, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::random_access_iterator< Buffer >
+constexpr void mergeRuns(Itr             begin,
+                         Itr             middle,
+                         Itr             end,
+                         Buffer          buffer,
+                         Compare         compare,
+                         std::ptrdiff_t& gallop) {
+  begin = gallopUpper(begin, middle, *middle, compare);
+  if (begin == middle) { return; }
+
+  end = gallopLower(middle, end, *std::prev(middle), compare);
+
+  if (std::distance(begin, middle) <= std::distance(middle, end)) {
+    const auto bufferEnd = std::move(begin, middle, buffer);
+    mergeLow(buffer, bufferEnd, middle, end, begin, compare, gallop);
+  } else {
+    const auto bufferEnd = std::move(middle, end, buffer);
+
+    const auto reversed = [&compare](const auto& lhs, const auto& rhs) {
+      return compare(rhs, lhs);
+    };
+    mergeLow(std::make_reverse_iterator(bufferEnd),
+             std::make_reverse_iterator(buffer),
+             std::make_reverse_iterator(middle),
+             std::make_reverse_iterator(begin),
+             std::make_reverse_iterator(end),
+             reversed,
+             gallop);
+  }
+}
+
+/**
+ * @brief TimSort with a caller provided buffer.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Buffer Buffer iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param buffer Iterator to a buffer of at least half of the size of the
+ * range plus one element.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr and Buffer to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Splits the range into natural runs, extended to minRunLength with
+ * binary insertion, and keeps them on a stack. Runs are merged whenever the
+ * lengths on top of the stack stop shrinking like the Fibonacci numbers,
+ * which bounds the stack and keeps the merges balanced.
+ */
+template< typename Itr, typename Buffer, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::random_access_iterator< Buffer >
+constexpr void timBuffered(Itr begin, Itr end, Buffer buffer, Compare compare) {
+  const auto size = std::distance(begin, end);
+  if (size < 2) { return; }
+
+  if (size < minMerge) {
+    insertionExtend(begin, countRun(begin, end, compare), end, compare);
+    return;
+  }
+
+  const auto     minRun = minRunLength(size);
+  std::ptrdiff_t gallop = minGallop;
+
+  ds::DynamicArray< Run > runs{};
+  runs.reserve(maxRuns);
+
+  const auto mergeAt = [&](std::ptrdiff_t index) {
+    auto&       lower = runs[index];
+    const auto& upper = runs[index + 1];
+
+    mergeRuns(std::next(begin, lower.begin),
+              std::next(begin, upper.begin),
+              std::next(begin, upper.begin + upper.size),
+              buffer,
+              compare,
+              gallop);
+    lower.size += upper.size;
+
+    // Drop the upper run, the one above it (if any) moves down
+    if (index + 2 < static_cast< std::ptrdiff_t >(runs.size())) {
+      runs[index + 1] = runs[index + 2];
+    }
+    runs.pop_back();
+  };
+
+  auto current = begin;
+  while (current != end) {
+    auto       runEnd    = countRun(current, end, compare);
+    const auto remaining = std::distance(current, end);
+
+    if (std::distance(current, runEnd) < minRun) {
+      const auto forced = std::next(current, std::min(minRun, remaining));
+      insertionExtend(current, runEnd, forced, compare);
+      runEnd = forced;
+    }
+
+    runs.push_back(Run{ std::distance(begin, current),
+                        std::distance(current, runEnd) });
+    current = runEnd;
+
+    // Restore the invariants on the run lengths at the top of the stack
+    while (runs.size() > 1) {
+      auto index = static_cast< std::ptrdiff_t >(runs.size()) - 2;
+
+      if ((index > 0 &&
+           runs[index - 1].size <= runs[index].size + runs[index + 1].size) ||
+          (index > 1 &&
+           runs[index - 2].size <= runs[index - 1].size + runs[index].size)) {
+        if (runs[index - 1].size < runs[index + 1].size) { --index; }
+      } else if (runs[index].size > runs[index + 1].size) {
+        break;
+      }
+
+      mergeAt(index);
+    }
+  }
+
+  // Merge the remaining runs, smaller neighbours first
+  while (runs.size() > 1) {
+    auto index = static_cast< std::ptrdiff_t >(runs.size()) - 2;
+    if (index > 0 && runs[index - 1].size < runs[index + 1].size) { --index; }
+
+    mergeAt(index);
+  }
+}
+
+/**
+ * @brief TimSort.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Allocates the buffer for timBuffered, only for ranges that need
+ * merging.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr >
+constexpr void tim(Itr begin, Itr end, Compare compare) {
+  const auto size = std::distance(begin, end);
+
+  if (size < minMerge) {
+    timBuffered(begin, end, begin, compare);
+    return;
+  }
+
+  ds::DynamicArray< std::iter_value_t< Itr > > scratch(
+    static_cast< std::size_t >(size / 2 + 1));
+  timBuffered(begin, end, std::begin(scratch), compare);
+}
+
+/**
+ * @brief Split point of a merge along the merge path.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param first Iterator to the beginning of the first sorted range.
+ * @param firstSize Size of the first range.
+ * @param second Iterator to the beginning of the second sorted range.
+ * @param secondSize Size of the second range.
+ * @param diagonal Number of elements in the merged prefix.
+ * @param compare Comparison function.
+ * @return Number of elements of the first range in the merged prefix, the
+ * rest of the prefix comes from the second range.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Binary search along the diagonal of the merge grid, O(log n).
+ * Equal elements are taken from the first range first, the same as
+ * std::merge, so merging the pieces between split points separately gives
+ * exactly the stable merge.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr >
+[[nodiscard]] constexpr std::ptrdiff_t coRank(Itr            first,
+                                              std::ptrdiff_t firstSize,
+                                              Itr            second,
+                                              std::ptrdiff_t secondSize,
+                                              std::ptrdiff_t diagonal,
+                                              Compare        compare) {
+  auto low  = std::max< std::ptrdiff_t >(0, diagonal - secondSize);
+  auto high = std::min(diagonal, firstSize);
+
+  // Find the first split where the next element of the first range comes
+  // after the last taken element of the second range
+  while (low < high) {
+    const auto taken = low + (high - low) / 2;
+    const auto other = diagonal - taken;
+
+    if (other > 0 && !compare(*std::next(second, other - 1),
+                              *std::next(first, taken))) {
+      low = taken + 1;
+    } else {
+      high = taken;
+    }
+  }
+
+  return low;
+}
+
+/**
+ * @brief Merge one of equal parts of two adjacent sorted ranges.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam From Source iterator type.
+ * @tparam To Destination iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the first range.
+ * @param middle Iterator to the end of the first and beginning of the second
+ * range.
+ * @param end Iterator to the end of the second range.
+ * @param destination Iterator to the beginning of the destination.
+ * @param part Index of the part.
+ * @param parts Number of parts.
+ * @param compare Comparison function.
+ *
+ * @attention Requires From and To to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details The output is cut into parts of equal size and the inputs are cut
+ * at the matching coRank split points, so the parts are independent and
+ * equally expensive.
+ */
+template< typename From, typename To, typename Compare >
+requires std::random_access_iterator< From > &&
+         std::random_access_iterator< To >
+constexpr void mergePart(From           begin,
+                         From           middle,
+                         From           end,
+                         To             destination,
+                         std::ptrdiff_t part,
+                         std::ptrdiff_t parts,
+                         Compare        compare) {
+  const auto firstSize  = std::distance(begin, middle);
+  const auto secondSize = std::distance(middle, end);
+  const auto size       = firstSize + secondSize;
+
+  const auto outBegin = size * part / parts;
+  const auto outEnd   = size * (part + 1) / parts;
+
+  const auto firstBegin =
+    coRank(begin, firstSize, middle, secondSize, outBegin, compare);
+  const auto firstEnd =
+    coRank(begin, firstSize, middle, secondSize, outEnd, compare);
+
+  std::merge(std::make_move_iterator(std::next(begin, firstBegin)),
+             std::make_move_iterator(std::next(begin, firstEnd)),
+             std::make_move_iterator(std::next(middle, outBegin - firstBegin)),
+             std::make_move_iterator(std::next(middle, outEnd - firstEnd)),
+             std::next(destination, outBegin),
+             compare);
+}
+
+/**
+ * @brief Tournament tree of losers over k sorted sources.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Before Function object type, Before(a, b) tells whether the head of
+ * source a goes out before the head of source b.
+ *
+ * @details Every inner node of the implicit complete binary tree keeps the
+ * source that lost the match played there, node 0 keeps the overall winner.
+ * After the winner advanced, only the matches on the path from its leaf to
+ * the root are replayed, about log2(k) calls to Before per element. Exhausted
+ * sources act as sentinels greater than every element, so Before must never
+ * let them win against a source that is not exhausted. Sources are not
+ * stored, Before reads their heads.
+ */
+template< typename Before >
+class LoserTree {
+public:
+  /**
+   * @brief Construct the tree and play the initial tournament.
+   * @param sources Number of sources, at least 1.
+   * @param order Order of the heads of two sources.
+   */
+  LoserTree(std::size_t sources, Before order):
+    count{ sources }, before{ std::move(order) }, losers(sources) {
+    ds::DynamicArray< std::size_t > winners(2 * count);
+    for (std::size_t source = 0; source < count; ++source) {
+      winners[count + source] = source;
+    }
+
+    for (auto node = count - 1; node > 0; --node) {
+      const auto left  = winners[2 * node];
+      const auto right = winners[2 * node + 1];
+
+      if (before(right, left)) {
+        winners[node] = right;
+        losers[node]  = left;
+      } else {
+        winners[node] = left;
+        losers[node]  = right;
+      }
+    }
+
+    losers[0] = count > 1 ? winners[1] : 0;
+  }
+
+  /**
+   * @brief Get the source whose head goes out next.
+   * @note Nodiscard.
+   * @return Index of the winning source.
+   */
+  [[nodiscard]] std::size_t winner() const {
+    return losers[0];
+  }
+
+  /**
+   * @brief Replay the matches of the winner after its head changed.
+   */
+  void replay() {
+    auto current = losers[0];
+
+    for (auto node = (current + count) / 2; node > 0; node /= 2) {
+      const auto challenger = losers[node];
+      const bool wins       = before(challenger, current);
+
+      losers[node] = wins ? current : challenger;
+      current      = wins ? challenger : current;
+    }
+
+    losers[0] = current;
+  }
+
+private:
+  std::size_t                     count;
+  Before                          before;
+  ds::DynamicArray< std::size_t > losers;
+};
+
+/**
+ * @brief Merge sorted sources with a loser tree.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Source Iterator type of the sources.
+ * @tparam Out Destination iterator type.
+ * @tparam Compare Comparison function type.
+ * @param heads Iterators to the first unmerged element of every source,
+ * advanced to the ends.
+ * @param ends Iterators to the ends of the sources.
+ * @param out Iterator to the beginning of the destination.
+ * @param compare Comparison function.
+ * @return Iterator past the last merged element.
+ *
+ * @attention Requires Source and Out to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Single pass, about log2(k) comparisons per element for k sources.
+ * Exhausted sources are sentinels that lose every match. Equal elements are
+ * taken from the earlier source first, so the merge is stable. One or two
+ * sources are copied or merged directly.
+ */
+template< typename Source, typename Out, typename Compare >
+requires std::random_access_iterator< Source > &&
+         std::random_access_iterator< Out >
+constexpr Out kwayMerge(ds::DynamicArray< Source >&       heads,
+                        const ds::DynamicArray< Source >& ends,
+                        Out                               out,
+                        Compare                           compare) {
+  std::ptrdiff_t remaining = 0;
+  for (std::size_t source = 0; source < heads.size(); ++source) {
+    remaining += std::distance(heads[source], ends[source]);
+  }
+  if (remaining == 0) { return out; }
+  if (heads.size() == 1) { return std::copy(heads[0], ends[0], out); }
+  if (heads.size() == 2) {
+    return std::merge(heads[0], ends[0], heads[1], ends[1], out, compare);
+  }
+
+  const auto before = [&heads, &ends, &compare](std::size_t left,
+                                                std::size_t right) -> bool {
+    if (heads[left] == ends[left]) { return false; }
+    if (heads[right] == ends[right]) { return true; }
+
+    // Ties go to the earlier source, selecting instead of branching on it
+    const bool ordered = left < right;
+    const auto earlier = ordered ? left : right;
+    const auto later   = ordered ? right : left;
+
+    return compare(*heads[later], *heads[earlier]) != ordered;
+  };
+
+  LoserTree tree{ heads.size(), before };
+  for (; remaining > 0; --remaining) {
+    auto& head = heads[tree.winner()];
+
+    *out = *head;
+    out  = std::next(out);
+    head = std::next(head);
+    tree.replay();
+  }
+
+  return out;
+}
+
+/**
+ * @brief Find where the sources of a k-way merge are cut for a prefix of the
+ * output.
+ * @headerfile aizo_sort_merge_impl.hpp
+ *
+ * @tparam Source Iterator type of the sources.
+ * @tparam SplitItr Iterator type of the split points.
+ * @tparam Compare Comparison function type.
+ * @param begins Iterators to the beginnings of the sorted sources.
+ * @param ends Iterators to the ends of the sorted sources.
+ * @param diagonal Number of elements in the merged prefix.
+ * @param splits Iterator to the destination of one split point per source,
+ * the number of its elements in the merged prefix.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Source and SplitItr to be at least of category
+ * RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Multi-sequence counterpart of coRank. Keeps a window of possible
+ * split points per source and ranks the middle element of the widest window
+ * by binary searches in all windows, which narrows every window on the same
+ * side. Equal elements are ordered by source like in kwayMerge, so merging
+ * the pieces between split points separately gives exactly the stable merge.
+ */
+template< typename Source, typename SplitItr, typename Compare >
+requires std::random_access_iterator< Source > &&
+         std::random_access_iterator< SplitItr >
+constexpr void multiCoRank(const ds::DynamicArray< Source >& begins,
+                           const ds::DynamicArray< Source >& ends,
+                           std::ptrdiff_t                    diagonal,
+                           SplitItr                          splits,
+                           Compare                           compare) {
+  const auto count = begins.size();
+
+  ds::DynamicArray< std::ptrdiff_t > low(count);
+  ds::DynamicArray< std::ptrdiff_t > high(count);
+  ds::DynamicArray< std::ptrdiff_t > rank(count);
+
+  std::ptrdiff_t lowSum  = 0;
+  std::ptrdiff_t highSum = 0;
+  for (std::size_t source = 0; source < count; ++source) {
+    low[source]   = 0;
+    high[source]  = std::distance(begins[source], ends[source]);
+    highSum      += high[source];
+  }
+
+  while (lowSum < diagonal && highSum > diagonal) {
+    std::size_t widest = 0;
+    for (std::size_t source = 1; source < count; ++source) {
+      if (high[source] - low[source] > high[widest] - low[widest]) {
+        widest = source;
+      }
+    }
+
+    const auto  middle = low[widest] + (high[widest] - low[widest]) / 2;
+    const auto& pivot  = *std::next(begins[widest], middle);
+
+    // Elements before the pivot, clamped to the windows
+    std::ptrdiff_t before = 0;
+    for (std::size_t source = 0; source < count; ++source) {
+      const auto first = std::next(begins[source], low[source]);
+      const auto last  = std::next(begins[source], high[source]);
+
+      if (source < widest) {
+        rank[source] =
+          std::distance(begins[source],
+                        std::upper_bound(first, last, pivot, compare));
+      } else if (source == widest) {
+        rank[source] = middle;
+      } else {
+        rank[source] =
+          std::distance(begins[source],
+                        std::lower_bound(first, last, pivot, compare));
+      }
+      before += rank[source];
+    }
+
+    if (before < diagonal) {
+      rank[widest] = middle + 1;
+
+      lowSum = 0;
+      for (std::size_t source = 0; source < count; ++source) {
+        low[source]  = rank[source];
+        lowSum      += low[source];
+      }
+    } else {
+      highSum = 0;
+      for (std::size_t source = 0; source < count; ++source) {
+        high[source]  = rank[source];
+        highSum      += high[source];
+      }
+    }
+  }
+
+  const auto& result = lowSum == diagonal ? low : high;
+  std::copy(std::begin(result), std::end(result), splits);
+}
+
+} // namespace aizo::sort::merge::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_MERGE_IMPL_HPP
@@ -0,0 +1,80 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_NETWORK_HPP
+#define UNI_AIZO_P_AIZO_SORT_NETWORK_HPP
+
+#include "aizo_sort_network_impl.hpp"
+
+/**
+ * @brief Sorting networks for small ranges.
+ */
+namespace aizo::sort::network {
+
+/**
+ * @brief Sort exactly Size elements with a sorting network.
+ * @category Sort
+ * @note Time complexity: O(Size log^2 Size), independent of the input.
+ * @headerfile aizo_sort_network.hpp
+ *
+ * @tparam Size Number of elements, at most impl::maxSize.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the first of the Size elements.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Batcher's odd-even merge sort network, generated at compile time
+ * and fully unrolled. The sequence of compare-exchanges does not depend on the
+ * data, for arithmetic keys they are branch free. Not stable.
+ */
+template< std::size_t Size, typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool > &&
+         (Size <= impl::maxSize)
+constexpr void sort(Itr begin, Compare compare = Compare{}) {
+  impl::apply< Size >(
+    begin, compare, std::make_index_sequence< impl::network< Size >.size() >{});
+}
+
+/**
+ * @brief Sort a range of up to MaxSize elements with a sorting network.
+ * @category Sort
+ * @note Time complexity: O(n log^2 n).
+ * @headerfile aizo_sort_network.hpp
+ *
+ * @tparam MaxSize Largest supported range, at most impl::maxSize.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ * @attention Requires the range to hold at most MaxSize elements.
+ *
+ * @details Picks the network for the size of the range. Meant as the base case
+ * of recursive sorts.
+ */
+template< std::size_t MaxSize, typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool > &&
+         (MaxSize <= impl::maxSize)
+constexpr void bounded(Itr begin, Itr end, Compare compare = Compare{}) {
+  const auto size = static_cast< std::size_t >(std::distance(begin, end));
+
+  [&]< std::size_t... Size >(std::index_sequence< Size... > /*sizes*/) {
+    static_cast< void >(
+      ((size == Size && (sort< Size >(begin, compare), true)) || ...));
+  }(std::make_index_sequence< MaxSize + 1 >{});
+}
+
+} // namespace aizo::sort::network
+
+#endif // UNI_AIZO_P_AIZO_SORT_NETWORK_HPP
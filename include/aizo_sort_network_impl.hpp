@@ -0,0 +1,185 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_NETWORK_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_NETWORK_IMPL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Implementation specific functionality for sorting networks.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::network::impl {
+
+/**
+ * @brief Largest supported network size.
+ */
+inline constexpr std::size_t maxSize = 32;
+
+/**
+ * @brief Pair of positions compared and exchanged by the network.
+ */
+struct Comparator {
+  std::uint8_t first;
+  std::uint8_t second;
+};
+
+/**
+ * @brief Walk the comparators of Batcher's odd-even merge sort.
+ * @headerfile aizo_sort_network_impl.hpp
+ *
+ * @tparam Visit Callable taking the two positions of a comparator.
+ * @param size Number of inputs.
+ * @param visit Called for every comparator, in network order.
+ *
+ * @details Builds the network for the next power of two and drops the
+ * comparators touching the padding. Padding acts as keys larger than
+ * everything, so those comparators would never exchange anything.
+ */
+template< typename Visit >
+requires std::invocable< Visit&, std::size_t, std::size_t >
+constexpr void batcher(std::size_t size, Visit visit) {
+  const auto padded = std::bit_ceil(size);
+
+  for (std::size_t merge = 1; merge < padded; merge *= 2) {
+    for (std::size_t stride = merge; stride > 0; stride /= 2) {
+      for (std::size_t block = stride % merge; block + stride < padded;
+           block += 2 * stride) {
+        for (std::size_t i = 0; i < std::min(stride, padded - block - stride);
+             ++i) {
+          const auto first  = block + i;
+          const auto second = first + stride;
+
+          // Only compare within the same pair of merged blocks
+          if (first / (2 * merge) == second / (2 * merge) && second < size) {
+            visit(first, second);
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Number of comparators of the network for size inputs.
+ * @headerfile aizo_sort_network_impl.hpp
+ *
+ * @param size Number of inputs.
+ * @return Number of comparators.
+ *
+ * @attention Nodiscard.
+ */
+[[nodiscard]] consteval std::size_t comparatorCount(std::size_t size) {
+  std::size_t count = 0;
+  batcher(size, [&count](std::size_t /*first*/, std::size_t /*second*/) {
+    ++count;
+  });
+
+  return count;
+}
+
+/**
+ * @brief Comparators of the network for Size inputs.
+ * @headerfile aizo_sort_network_impl.hpp
+ *
+ * @tparam Size Number of inputs.
+ * @return Comparators in network order.
+ *
+ * @attention Nodiscard.
+ */
+template< std::size_t Size >
+[[nodiscard]] consteval std::array< Comparator, comparatorCount(Size) >
+makeNetwork() {
+  std::array< Comparator, comparatorCount(Size) > result{};
+  std::size_t                                     index = 0;
+  batcher(Size, [&](std::size_t first, std::size_t second) {
+    result[index++] = Comparator{ static_cast< std::uint8_t >(first),
+                                  static_cast< std::uint8_t >(second) };
+  });
+
+  return result;
+}
+
+/**
+ * @brief Network for Size inputs, generated at compile time.
+ */
+template< std::size_t Size >
+inline constexpr auto network = makeNetwork< Size >();
+
+/**
+ * @brief Put two elements in order.
+ * @headerfile aizo_sort_network_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param first Iterator to the element that should be the smaller one.
+ * @param second Iterator to the element that should be the larger one.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Arithmetic keys are written back as a selected minimum and
+ * maximum, which compiles to conditional moves or min/max instructions
+ * instead of a branch. Other types are swapped when out of order.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void compareExchange(Itr first, Itr second, Compare compare) {
+  if constexpr (std::is_arithmetic_v< std::iter_value_t< Itr > >) {
+    const auto lhs     = *first;
+    const auto rhs     = *second;
+    const bool swapped = compare(rhs, lhs);
+
+    *first  = swapped ? rhs : lhs;
+    *second = swapped ? lhs : rhs;
+  } else {
+    if (compare(*second, *first)) { std::iter_swap(first, second); }
+  }
+}
+
+/**
+ * @brief Run the network for Size inputs on a range.
+ * @headerfile aizo_sort_network_impl.hpp
+ *
+ * @tparam Size Number of inputs.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @tparam Index Indices of the comparators.
+ * @param begin Iterator to the beginning of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Fully unrolled, every comparator is a separate compare-exchange
+ * on fixed positions.
+ */
+template< std::size_t Size,
+          typename Itr,
+          typename Compare,
+          std::size_t... Index >
+requires std::random_access_iterator< Itr >
+constexpr void apply([[maybe_unused]] Itr     begin,
+                     [[maybe_unused]] Compare compare,
+                     std::index_sequence< Index... > /*indices*/) {
+  (compareExchange(std::next(begin, network< Size >[Index].first),
+                   std::next(begin, network< Size >[Index].second),
+                   compare),
+   ...);
+}
+
+} // namespace aizo::sort::network::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_NETWORK_IMPL_HPP
@@ -1,13 +1,108 @@
 #ifndef UNI_AIZO_P_AIZO_SORT_QUICK_HPP
 #define UNI_AIZO_P_AIZO_SORT_QUICK_HPP
 
+#include "aizo_sort_heap.hpp"
+#include "aizo_sort_insertion.hpp"
 #include "aizo_sort_quick_impl.hpp"
+#include "aizo_sort_select.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
 
 /**
  * @brief Insertion sortFunction algorithms.
  */
 namespace aizo::sort::quick {
 
+/**
+ * @brief Pivot selection strategies.
+ *
+ * @details Each strategy is a function object taking (begin, end, compare) of
+ * a range with at least 3 elements and returning an iterator to the chosen
+ * pivot inside the range. Strategies may keep state between calls.
+ */
+namespace pivot {
+
+/**
+ * @brief Middle element of the range.
+ */
+struct Middle {
+  template< typename Itr, typename Compare >
+  requires std::random_access_iterator< Itr >
+  [[nodiscard]] constexpr Itr operator()(Itr begin,
+                                         Itr end,
+                                         Compare /*compare*/) const {
+    return std::next(begin, std::distance(begin, end) / 2);
+  }
+};
+
+/**
+ * @brief Median of the first, the middle and the last element.
+ */
+struct MedianOfThree {
+  template< typename Itr, typename Compare >
+  requires std::random_access_iterator< Itr >
+  [[nodiscard]] constexpr Itr operator()(Itr     begin,
+                                         Itr     end,
+                                         Compare compare) const {
+    return impl::medianOfThree(begin,
+                               std::next(begin, std::distance(begin, end) / 2),
+                               std::prev(end),
+                               compare);
+  }
+};
+
+/**
+ * @brief Tukey's ninther, the median of the medians of three triples.
+ * @note Falls back to the median of three for fewer than 9 elements.
+ */
+struct Ninther {
+  template< typename Itr, typename Compare >
+  requires std::random_access_iterator< Itr >
+  [[nodiscard]] constexpr Itr operator()(Itr     begin,
+                                         Itr     end,
+                                         Compare compare) const {
+    const auto size = std::distance(begin, end);
+    if (size < 9) { return MedianOfThree{}(begin, end, compare); }
+
+    const auto step   = size / 8;
+    const auto middle = std::next(begin, size / 2);
+    const auto last   = std::prev(end);
+
+    return impl::medianOfThree(
+      impl::medianOfThree(
+        begin, std::next(begin, step), std::next(begin, 2 * step), compare),
+      impl::medianOfThree(
+        std::prev(middle, step), middle, std::next(middle, step), compare),
+      impl::medianOfThree(
+        std::prev(last, 2 * step), std::prev(last, step), last, compare),
+      compare);
+  }
+};
+
+/**
+ * @brief Pseudo-random element of the range.
+ * @note Deterministic, driven by a xorshift generator with a fixed seed.
+ */
+struct PseudoRandom {
+  std::uint64_t state{ 0x9E3779B97F4A7C15ULL };
+
+  template< typename Itr, typename Compare >
+  requires std::random_access_iterator< Itr >
+  [[nodiscard]] constexpr Itr operator()(Itr begin,
+                                         Itr end,
+                                         Compare /*compare*/) {
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+
+    const auto size = static_cast< std::uint64_t >(std::distance(begin, end));
+    return std::next(begin, static_cast< std::ptrdiff_t >(state % size));
+  }
+};
+
+} // namespace pivot
+
 /**
  * @brief Classic quick sort algorithm.
  * @category Sort
@@ -41,6 +136,398 @@ constexpr void classic(Itr begin, Itr end, Compare compare = Compare{}) {
   }
 }
 
+/**
+ * @brief Introspective quick sort algorithm with an explicit depth budget.
+ * @category Sort
+ * @note Time complexity: O(n log n).
+ * @headerfile aizo_sort_quick.hpp
+ *
+ * @tparam NetworkSize Largest range finished with a sorting network, 0 for
+ * insertion sort.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @param depthBudget Number of partitioning levels allowed before the range is
+ * handed over to heap sort.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Partitions around a median-of-three pivot, recurses into the
+ * smaller partition and loops on the larger one, so the stack depth stays
+ * below log2(n). Once the depth budget is spent the range is sorted with heap
+ * sort. Ranges of impl::insertionThreshold elements or fewer are finished with
+ * insertion sort, or ranges of NetworkSize elements or fewer with
+ * network::bounded if NetworkSize is not 0.
+ */
+template< std::size_t NetworkSize = 0, typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void intro(Itr            begin,
+                     Itr            end,
+                     Compare        compare,
+                     std::ptrdiff_t depthBudget) {
+  while (std::distance(begin, end) > impl::smallThreshold< NetworkSize >) {
+    // Out of budget, the pivots were bad. Guarantee O(n log n) with heap sort.
+    if (depthBudget == 0) {
+      heap::classic(begin, end, compare);
+      return;
+    }
+    --depthBudget;
+
+    const auto cut = impl::partitionMedianOfThree(begin, end, compare);
+
+    // Recurse into the smaller side, keep looping on the larger one
+    if (std::distance(begin, cut) < std::distance(cut, end)) {
+      intro< NetworkSize >(begin, cut, compare, depthBudget);
+      begin = cut;
+    } else {
+      intro< NetworkSize >(cut, end, compare, depthBudget);
+      end = cut;
+    }
+  }
+
+  impl::sortSmall< NetworkSize >(begin, end, compare);
+}
+
+/**
+ * @brief Introspective quick sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n).
+ * @headerfile aizo_sort_quick.hpp
+ *
+ * @tparam NetworkSize Largest range finished with a sorting network, 0 for
+ * insertion sort.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Quick sort with a depth budget of 2 * floor(log2(n)) levels, see
+ * the overload taking the budget explicitly. Safe on adversarial input.
+ */
+template< std::size_t NetworkSize = 0,
+          typename Itr,
+          typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void intro(Itr begin, Itr end, Compare compare = Compare{}) {
+  intro< NetworkSize >(begin,
+                       end,
+                       compare,
+                       impl::depthBudget(std::distance(begin, end)));
+}
+
+/**
+ * @brief Three-way (fat pivot) quick sort algorithm with a depth budget.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n k) for k distinct keys.
+ * @headerfile aizo_sort_quick.hpp
+ *
+ * @tparam NetworkSize Largest range finished with a sorting network, 0 for
+ * insertion sort.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @param depthBudget Number of partitioning levels allowed before the range is
+ * handed over to heap sort.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Groups all keys equal to the pivot, the median of three or the
+ * ninther for larger ranges, in one pass and never recurses into them, so
+ * inputs with few distinct keys are sorted in close to linear time. Recurses
+ * into the smaller side and loops on the larger one. Once the depth budget is
+ * spent the range is sorted with heap sort. Ranges of impl::insertionThreshold
+ * elements or fewer are finished with insertion sort, or ranges of NetworkSize
+ * elements or fewer with network::bounded if NetworkSize is not 0.
+ */
+template< std::size_t NetworkSize = 0, typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void threeWay(Itr            begin,
+                        Itr            end,
+                        Compare        compare,
+                        std::ptrdiff_t depthBudget) {
+  while (std::distance(begin, end) > impl::smallThreshold< NetworkSize >) {
+    // Out of budget, the pivots were bad. Guarantee O(n log n) with heap sort.
+    if (depthBudget == 0) {
+      heap::classic(begin, end, compare);
+      return;
+    }
+    --depthBudget;
+
+    const auto [equalBegin, equalEnd] =
+      impl::partitionThreeWay(begin, end, compare);
+
+    // Equal keys are already in place, only the outer parts are left
+    if (std::distance(begin, equalBegin) < std::distance(equalEnd, end)) {
+      threeWay< NetworkSize >(begin, equalBegin, compare, depthBudget);
+      begin = equalEnd;
+    } else {
+      threeWay< NetworkSize >(equalEnd, end, compare, depthBudget);
+      end = equalBegin;
+    }
+  }
+
+  impl::sortSmall< NetworkSize >(begin, end, compare);
+}
+
+/**
+ * @brief Three-way (fat pivot) quick sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n k) for k distinct keys.
+ * @headerfile aizo_sort_quick.hpp
+ *
+ * @tparam NetworkSize Largest range finished with a sorting network, 0 for
+ * insertion sort.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Three-way quick sort with a depth budget of 2 * floor(log2(n))
+ * levels, see the overload taking the budget explicitly. Safe on sorted,
+ * reversed and adversarial input.
+ */
+template< std::size_t NetworkSize = 0,
+          typename Itr,
+          typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void threeWay(Itr begin, Itr end, Compare compare = Compare{}) {
+  threeWay< NetworkSize >(begin,
+                          end,
+                          compare,
+                          impl::depthBudget(std::distance(begin, end)));
+}
+
+/**
+ * @brief Pattern-defeating quick sort algorithm (pdqsort).
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n) on sorted, reversed and equal keys.
+ * @headerfile aizo_sort_quick.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Introsort variant after Orson Peters. Detects ranges that were
+ * already partitioned and finishes them with a bounded insertion sort, puts
+ * keys equal to the previous pivot aside in one pass, breaks patterns with a
+ * few swaps after a bad split and falls back to heap sort after log2(n) bad
+ * splits. Arithmetic keys with the standard comparators are partitioned
+ * branchlessly in blocks.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void pdq(Itr begin, Itr end, Compare compare = Compare{}) {
+  impl::pdqSort(begin, end, compare);
+}
+
+/**
+ * @brief Dual-pivot quick sort algorithm (Yaroslavskiy).
+ * @category Sort
+ * @note Time complexity: O(n^2).
+ * @headerfile aizo_sort_quick.hpp
+ *
+ * @tparam Pivot Pivot selection strategy, see aizo::sort::quick::pivot.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Picks one pivot from each half of the range with the Pivot
+ * strategy and splits the range three ways around them in a single pass,
+ * which needs fewer passes over memory than two-way partitioning. The middle
+ * part is skipped when both pivots are equal. Recurses into the two smaller
+ * parts and loops on the largest one. Ranges of impl::insertionThreshold
+ * elements or fewer are finished with insertion sort.
+ */
+template< typename Pivot = pivot::MedianOfThree,
+          typename Itr,
+          typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void dualPivot(Itr     begin,
+                         Itr     end,
+                         Compare compare  = Compare{},
+                         Pivot   strategy = Pivot{}) {
+  while (std::distance(begin, end) > impl::insertionThreshold) {
+    const auto middle = std::next(begin, std::distance(begin, end) / 2);
+
+    // One pivot from each half, lower one to the front, upper one to the back
+    std::iter_swap(begin, strategy(begin, middle, compare));
+    std::iter_swap(std::prev(end), strategy(middle, end, compare));
+    impl::sortTwo(begin, std::prev(end), compare);
+
+    const bool equalPivots = !compare(*begin, *std::prev(end));
+
+    const auto [lower, upper] = impl::partitionDualPivot(begin, end, compare);
+
+    // Order the three parts by size, the largest one is handled by the loop
+    std::pair< Itr, Itr > parts[3]{ { begin, lower }, // NOLINT
+                                    { std::next(lower), upper },
+                                    { std::next(upper), end } };
+    if (equalPivots) { parts[1] = { upper, upper }; }
+
+    auto largest = 0;
+    for (auto i = 1; i < 3; ++i) {
+      if (std::distance(parts[i].first, parts[i].second) >
+          std::distance(parts[largest].first, parts[largest].second)) {
+        largest = i;
+      }
+    }
+
+    for (auto i = 0; i < 3; ++i) {
+      if (i != largest) {
+        dualPivot(parts[i].first, parts[i].second, compare, strategy);
+      }
+    }
+
+    begin = parts[largest].first;
+    end   = parts[largest].second;
+  }
+
+  insertion::classic(begin, end, compare);
+}
+
+/**
+ * @brief Parallel quick sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n log n / threads) with enough cores.
+ * @headerfile aizo_sort_quick.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @param threads Number of threads to use, the calling thread included.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean
+ * and is safe to call concurrently.
+ *
+ * @details Runs the recursion as tasks on a work-stealing pool. The top
+ * levels, where a single range is larger than the work of one thread, are
+ * partitioned by all threads together. Below impl::parallelGrain elements, or
+ * when the depth budget runs out, ranges are sorted with pdq sequentially.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+void parallel(Itr         begin,
+              Itr         end,
+              Compare     compare = Compare{},
+              std::size_t threads = std::thread::hardware_concurrency()) {
+  const auto size = std::distance(begin, end);
+
+  if (threads <= 1 || size <= impl::parallelGrain) {
+    impl::pdqSort(begin, end, compare);
+    return;
+  }
+
+  tool::ThreadPool              pool{ threads - 1 };
+  std::atomic< std::ptrdiff_t > pending{ 0 };
+
+  impl::parallelTask(
+    pool, pending, begin, end, compare, impl::depthBudget(size));
+
+  // Help with the spawned subtasks until all of them are done
+  while (pending != 0) {
+    if (!pool.runPendingTask()) { std::this_thread::yield(); }
+  }
+}
+
+/**
+ * @brief Partial sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n + k log k) on average, O(n log k) for small k.
+ * @headerfile aizo_sort_quick.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param middle Iterator to the end of the part to sort.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Same result as heap::partial. For k up to n /
+ * impl::partialHeapRatio the bounded heap of heap::partial is used, most
+ * elements then cost a single comparison. For larger k the heap would be
+ * sifted too often, so the k-th element is selected with select::nthElement
+ * and the part before it is sorted with pdq.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void partial(Itr     begin,
+                       Itr     middle,
+                       Itr     end,
+                       Compare compare = Compare{}) {
+  if (begin == middle) { return; }
+
+  if (std::distance(begin, middle) * impl::partialHeapRatio <=
+      std::distance(begin, end)) {
+    heap::partial(begin, middle, end, compare);
+    return;
+  }
+
+  select::nthElement(begin, std::prev(middle), end, compare);
+  impl::pdqSort(begin, std::prev(middle), compare);
+}
+
 } // namespace aizo::sortFunction::quick
 
 #endif // UNI_AIZO_P_AIZO_SORT_QUICK_HPP
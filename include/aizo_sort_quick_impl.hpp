@@ -1,6 +1,22 @@
 #ifndef UNI_AIZO_P_AIZO_SORT_QUICK_IMPL_HPP
 #define UNI_AIZO_P_AIZO_SORT_QUICK_IMPL_HPP
 
+#include "aizo_sort_heap.hpp"
+#include "aizo_sort_insertion.hpp"
+#include "aizo_sort_network.hpp"
+#include "aizo_sort_quick_simd_impl.hpp"
+#include "aizo_tool_threadpool.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
 /**
  * @brief Implementation specific functionality for quick sort algorithms.
  *
@@ -23,6 +39,8 @@ namespace aizo::sort::quick::impl {
  * @attention Requires Compare to be a function object that returns bool.
  *
  * @details Chooses the pivot as the middle element of the array. Partitions the array around the pivot element and returns the pivot position.
+ * Contiguous ranges of simd::isKey elements with the standard comparators are
+ * partitioned with the vector kernels.
  */
 template< typename Itr, typename Compare = std::less<> >
 requires std::random_access_iterator< Itr > &&
@@ -38,6 +56,21 @@ constexpr Itr partition(Itr begin, Itr end, Compare compare = Compare{}) {
   // Move the pivot to the end
   std::iter_swap(pivot, std::prev(end));
 
+  if constexpr (simd::isVectorizable< Itr, Compare >) {
+    if (!std::is_constant_evaluated()) {
+      constexpr bool descending =
+        simd::isDescending< Compare, std::iter_value_t< Itr > >;
+
+      const auto first = std::to_address(begin);
+      const auto split = simd::partition< descending >(
+        first, std::to_address(std::prev(end)), pivotValue);
+      const auto low = std::next(begin, split - first);
+
+      std::iter_swap(low, std::prev(end));
+      return low;
+    }
+  }
+
   // Partition the array around the pivot
   auto low  = begin;
   auto high = std::prev(end);
@@ -60,6 +93,1277 @@ constexpr Itr partition(Itr begin, Itr end, Compare compare = Compare{}) {
   return low;
 }
 
+/**
+ * @brief Ranges of this size or smaller are finished with insertion sort.
+ */
+inline constexpr std::ptrdiff_t insertionThreshold = 16;
+
+/**
+ * @brief Ranges of this size or smaller are finished by sortSmall.
+ *
+ * @details A NetworkSize of 0 keeps insertionThreshold.
+ */
+template< std::size_t NetworkSize >
+inline constexpr std::ptrdiff_t smallThreshold =
+  NetworkSize == 0 ? insertionThreshold
+                   : static_cast< std::ptrdiff_t >(NetworkSize);
+
+/**
+ * @brief Base case of the recursive quick sorts.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam NetworkSize Largest range sorted with a sorting network, 0 for
+ * insertion sort.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires at most smallThreshold< NetworkSize > elements.
+ * @attention Requires NetworkSize to be 0 or at least 2, the partitions need
+ * 3 elements.
+ */
+template< std::size_t NetworkSize, typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool > &&
+         (NetworkSize == 0 || NetworkSize >= 2)
+constexpr void sortSmall(Itr begin, Itr end, Compare compare) {
+  if constexpr (NetworkSize == 0) {
+    insertion::classic(begin, end, compare);
+  } else {
+    network::bounded< NetworkSize >(begin, end, compare);
+  }
+}
+
+/**
+ * @brief Recursion depth budget for introspective quick sort.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @param size Size of the range.
+ * @return Depth budget, 2 * floor(log2(size)).
+ *
+ * @attention Nodiscard.
+ */
+[[nodiscard]] constexpr std::ptrdiff_t depthBudget(std::ptrdiff_t size) {
+  if (size < 2) { return 0; }
+
+  return 2 * (std::bit_width(static_cast< std::size_t >(size)) - 1);
+}
+
+/**
+ * @brief Move the median of three elements to the result position.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param result Iterator the median is swapped into.
+ * @param first Iterator to the first candidate.
+ * @param second Iterator to the second candidate.
+ * @param third Iterator to the third candidate.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Uses at most three comparisons. The result position may not be one
+ * of the candidates.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void moveMedianToFirst(
+  Itr result, Itr first, Itr second, Itr third, Compare compare) {
+  if (compare(*first, *second)) {
+    if (compare(*second, *third)) {
+      std::iter_swap(result, second);
+    } else if (compare(*first, *third)) {
+      std::iter_swap(result, third);
+    } else {
+      std::iter_swap(result, first);
+    }
+  } else if (compare(*first, *third)) {
+    std::iter_swap(result, first);
+  } else if (compare(*second, *third)) {
+    std::iter_swap(result, third);
+  } else {
+    std::iter_swap(result, second);
+  }
+}
+
+/**
+ * @brief Hoare partition around a pivot placed outside of the range.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param pivot Iterator to the pivot element.
+ * @param compare Comparison function.
+ * @return Iterator to the first element of the right partition.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires an element not less than the pivot in the range and an
+ * element not greater than the pivot at or before begin (no bound checks).
+ *
+ * @details Both scans stop on elements equal to the pivot, so runs of equal
+ * keys are split evenly instead of degenerating into quadratic behaviour.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr Itr partitionUnguarded(Itr     begin,
+                                 Itr     end,
+                                 Itr     pivot,
+                                 Compare compare) {
+  while (true) {
+    while (compare(*begin, *pivot)) { begin = std::next(begin); }
+
+    end = std::prev(end);
+    while (compare(*pivot, *end)) { end = std::prev(end); }
+
+    if (!(begin < end)) { return begin; }
+
+    std::iter_swap(begin, end);
+    begin = std::next(begin);
+  }
+}
+
+/**
+ * @brief Partition the array around a median-of-three pivot.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Iterator to the first element of the right partition.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires the range to contain at least 3 elements.
+ *
+ * @details Moves the median of the second, middle and last element to the
+ * front and partitions the rest around it. Every element of [begin, result)
+ * is not greater and every element of [result, end) is not less than the
+ * pivot. Both partitions are non-empty.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr Itr partitionMedianOfThree(Itr begin, Itr end, Compare compare) {
+  const auto middle = std::next(begin, std::distance(begin, end) / 2);
+
+  moveMedianToFirst(begin, std::next(begin), middle, std::prev(end), compare);
+
+  return partitionUnguarded(std::next(begin), end, begin, compare);
+}
+
+/**
+ * @brief Three-way (Dijkstra) partition around the first element.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Pair of iterators bounding the elements equal to the pivot.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires a non-empty range.
+ *
+ * @details Single pass over the range. After the call [begin, first) is less
+ * than, [first, second) is equal to and [second, end) is greater than the
+ * pivot. The equal block is never empty.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr std::pair< Itr, Itr > partitionThreeWayFirst(
+  Itr begin, Itr end, Compare compare) {
+  const auto pivotValue = *begin;
+
+  auto less    = begin;
+  auto current = std::next(begin);
+  auto greater = end;
+
+  // [begin, less) < pivot, [less, current) == pivot, [greater, end) > pivot
+  while (current < greater) {
+    if (compare(*current, pivotValue)) {
+      std::iter_swap(less, current);
+      less    = std::next(less);
+      current = std::next(current);
+    } else if (compare(pivotValue, *current)) {
+      greater = std::prev(greater);
+      std::iter_swap(current, greater);
+    } else {
+      current = std::next(current);
+    }
+  }
+
+  return { less, greater };
+}
+
+/**
+ * @brief Tuning constants of pattern-defeating quick sort.
+ */
+namespace pdq {
+inline constexpr std::ptrdiff_t insertionThreshold    = 24;
+inline constexpr std::ptrdiff_t nintherThreshold      = 128;
+inline constexpr std::ptrdiff_t partialInsertionLimit = 8;
+inline constexpr std::ptrdiff_t blockSize             = 64;
+} // namespace pdq
+
+/**
+ * @brief Check whether Compare is one of the standard ordering functors.
+ *
+ * @details Only for those (and arithmetic keys) comparing is cheap and free of
+ * side effects, which branchless and vectorized kernels rely on.
+ */
+template< typename Compare, typename Type >
+inline constexpr bool isDefaultCompare =
+  std::is_same_v< Compare, std::less<> > ||
+  std::is_same_v< Compare, std::greater<> > ||
+  std::is_same_v< Compare, std::less< Type > > ||
+  std::is_same_v< Compare, std::greater< Type > >;
+
+/**
+ * @brief Sort two elements in place.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param first Iterator to the first element.
+ * @param second Iterator to the second element.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void sortTwo(Itr first, Itr second, Compare compare) {
+  if (compare(*second, *first)) { std::iter_swap(first, second); }
+}
+
+/**
+ * @brief Sort three elements in place.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param first Iterator to the first element.
+ * @param second Iterator to the second element.
+ * @param third Iterator to the third element.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void sortThree(Itr first, Itr second, Itr third, Compare compare) {
+  sortTwo(first, second, compare);
+  sortTwo(second, third, compare);
+  sortTwo(first, second, compare);
+}
+
+/**
+ * @brief Three-way (Dijkstra) partition around a median pivot.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Pair of iterators bounding the elements equal to the pivot.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires the range to contain at least 3 elements.
+ *
+ * @details Moves the median of the first, middle and last element, or the
+ * ninther (Tukey) for ranges above pdq::nintherThreshold, to the front and
+ * partitions with partitionThreeWayFirst. The Dijkstra pass moves the first
+ * elements of a sorted greater block to its end, which defeats a plain median
+ * of three in the next round. The ninther takes the median of three medians
+ * of evenly spaced groups near the beginning, the middle and the end, so a
+ * few misplaced elements at either end sway only one group.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr std::pair< Itr, Itr > partitionThreeWay(
+  Itr begin, Itr end, Compare compare) {
+  const auto size   = std::distance(begin, end);
+  const auto middle = std::next(begin, size / 2);
+
+  if (size > pdq::nintherThreshold) {
+    // Medians of three local groups of samples, spread evenly
+    const auto step = size / 8;
+    const auto last = std::prev(end);
+
+    sortThree(
+      begin, std::next(begin, step), std::next(begin, 2 * step), compare);
+    sortThree(
+      std::prev(middle, step), middle, std::next(middle, step), compare);
+    sortThree(
+      std::prev(last, 2 * step), std::prev(last, step), last, compare);
+    sortThree(std::next(begin, step), middle, std::prev(last, step), compare);
+    std::iter_swap(begin, middle);
+  } else {
+    sortThree(middle, begin, std::prev(end), compare);
+  }
+
+  return partitionThreeWayFirst(begin, end, compare);
+}
+
+/**
+ * @brief Insertion sort that gives up after a fixed number of moves.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return True if the range got sorted, false if the attempt was abandoned.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Used on ranges that were already partitioned, which are likely to
+ * be (nearly) sorted. Stops after pdq::partialInsertionLimit element moves.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr bool partialInsertionSort(Itr     begin,
+                                                  Itr     end,
+                                                  Compare compare) {
+  if (begin == end) { return true; }
+
+  std::ptrdiff_t moves = 0;
+  for (auto current = std::next(begin); current != end;
+       current      = std::next(current)) {
+    auto hole = current;
+
+    // Compare first to avoid moving an element that is already in place
+    if (compare(*hole, *std::prev(hole))) {
+      auto value = std::move(*hole);
+
+      do {
+        *hole = std::move(*std::prev(hole));
+        hole  = std::prev(hole);
+      } while (hole != begin && compare(value, *std::prev(hole)));
+
+      *hole = std::move(value);
+      moves += std::distance(hole, current);
+    }
+
+    if (moves > pdq::partialInsertionLimit) { return false; }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Partition around the first element, equal elements go right.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Pivot position and whether the range was already partitioned.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires an element not less than the pivot in the range.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr std::pair< Itr, bool > partitionRight(
+  Itr begin, Itr end, Compare compare) {
+  auto pivotValue = std::move(*begin);
+  auto first      = begin;
+  auto last       = end;
+
+  // First element not less than the pivot, guaranteed to exist
+  do { first = std::next(first); } while (compare(*first, pivotValue));
+
+  // Last element less than the pivot, guarded if nothing precedes first
+  if (std::prev(first) == begin) {
+    while (first < last) {
+      last = std::prev(last);
+      if (compare(*last, pivotValue)) { break; }
+    }
+  } else {
+    do { last = std::prev(last); } while (!compare(*last, pivotValue));
+  }
+
+  // No pair to swap means the range was already partitioned
+  const bool alreadyPartitioned = first >= last;
+
+  // Previously swapped pairs guard the scans from here on
+  while (first < last) {
+    std::iter_swap(first, last);
+    do { first = std::next(first); } while (compare(*first, pivotValue));
+    do { last = std::prev(last); } while (!compare(*last, pivotValue));
+  }
+
+  const auto pivot = std::prev(first);
+  *begin           = std::move(*pivot);
+  *pivot           = std::move(pivotValue);
+
+  return { pivot, alreadyPartitioned };
+}
+
+/**
+ * @brief Swap elements at the recorded offsets of two blocks.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @param leftBase Base of the left block, offsets count forwards.
+ * @param rightBase Base of the right block, offsets count backwards.
+ * @param leftOffsets Offsets of misplaced elements in the left block.
+ * @param rightOffsets Offsets of misplaced elements in the right block.
+ * @param count Number of pairs to swap.
+ * @param useSwaps Swap pairwise instead of rotating through a cycle.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ *
+ * @details Rotating needs fewer moves, but pairwise swaps keep reversed input
+ * reversed within the blocks, which keeps descending input linear.
+ */
+template< typename Itr >
+requires std::random_access_iterator< Itr >
+constexpr void swapOffsets(Itr                 leftBase,
+                           Itr                 rightBase,
+                           const std::uint8_t* leftOffsets,
+                           const std::uint8_t* rightOffsets,
+                           std::ptrdiff_t      count,
+                           bool                useSwaps) {
+  if (useSwaps) {
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      std::iter_swap(leftBase + leftOffsets[i], rightBase - rightOffsets[i]);
+    }
+  } else if (count > 0) {
+    auto left  = leftBase + leftOffsets[0];
+    auto right = rightBase - rightOffsets[0];
+    auto value = std::move(*left);
+    *left      = std::move(*right);
+
+    for (std::ptrdiff_t i = 1; i < count; ++i) {
+      left   = leftBase + leftOffsets[i];
+      *right = std::move(*left);
+      right  = rightBase - rightOffsets[i];
+      *left  = std::move(*right);
+    }
+
+    *right = std::move(value);
+  }
+}
+
+/**
+ * @brief Branchless block partition around the first element.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Pivot position and whether the range was already partitioned.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires an element not less than the pivot in the range.
+ *
+ * @details Same contract as partitionRight. Comparison results are written
+ * into offset buffers of pdq::blockSize entries instead of being branched on
+ * (BlockQuicksort by Edelkamp and Weiss), misplaced elements are then swapped
+ * in bulk. Only pays off for cheap comparisons of arithmetic keys.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr std::pair< Itr, bool > partitionRightBranchless(
+  Itr begin, Itr end, Compare compare) {
+  auto pivotValue = std::move(*begin);
+  auto first      = begin;
+  auto last       = end;
+
+  do { first = std::next(first); } while (compare(*first, pivotValue));
+
+  if (std::prev(first) == begin) {
+    while (first < last) {
+      last = std::prev(last);
+      if (compare(*last, pivotValue)) { break; }
+    }
+  } else {
+    do { last = std::prev(last); } while (!compare(*last, pivotValue));
+  }
+
+  const bool alreadyPartitioned = first >= last;
+
+  if (!alreadyPartitioned) {
+    std::iter_swap(first, last);
+    first = std::next(first);
+
+    alignas(64) std::uint8_t leftOffsets[pdq::blockSize]{};  // NOLINT
+    alignas(64) std::uint8_t rightOffsets[pdq::blockSize]{}; // NOLINT
+
+    auto           leftBase   = first;
+    auto           rightBase  = last;
+    std::ptrdiff_t leftCount  = 0;
+    std::ptrdiff_t rightCount = 0;
+    std::ptrdiff_t leftStart  = 0;
+    std::ptrdiff_t rightStart = 0;
+
+    while (first < last) {
+      // Split the unknown elements between the blocks that need refilling
+      const auto unknown    = std::distance(first, last);
+      const auto leftSplit  = leftCount == 0
+                                ? (rightCount == 0 ? unknown / 2 : unknown)
+                                : 0;
+      const auto rightSplit = rightCount == 0 ? unknown - leftSplit : 0;
+
+      // Record offsets of elements on the wrong side without branching
+      const auto leftScan = std::min(leftSplit, pdq::blockSize);
+      for (std::ptrdiff_t i = 0; i < leftScan; ++i) {
+        leftOffsets[leftCount] = static_cast< std::uint8_t >(i);
+        leftCount +=
+          static_cast< std::ptrdiff_t >(!compare(*first, pivotValue));
+        first = std::next(first);
+      }
+
+      const auto rightScan = std::min(rightSplit, pdq::blockSize);
+      for (std::ptrdiff_t i = 1; i <= rightScan; ++i) {
+        last                     = std::prev(last);
+        rightOffsets[rightCount] = static_cast< std::uint8_t >(i);
+        rightCount += static_cast< std::ptrdiff_t >(compare(*last, pivotValue));
+      }
+
+      // Swap pairs of misplaced elements
+      const auto count = std::min(leftCount, rightCount);
+      swapOffsets(leftBase,
+                  rightBase,
+                  leftOffsets + leftStart,   // NOLINT
+                  rightOffsets + rightStart, // NOLINT
+                  count,
+                  leftCount == rightCount);
+      leftCount -= count;
+      rightCount -= count;
+      leftStart += count;
+      rightStart += count;
+
+      if (leftCount == 0) {
+        leftStart = 0;
+        leftBase  = first;
+      }
+      if (rightCount == 0) {
+        rightStart = 0;
+        rightBase  = last;
+      }
+    }
+
+    // One of the blocks may still hold misplaced elements, move them across
+    if (leftCount != 0) {
+      while (leftCount-- != 0) {
+        last = std::prev(last);
+        std::iter_swap(leftBase + leftOffsets[leftStart + leftCount], last);
+      }
+      first = last;
+    }
+    if (rightCount != 0) {
+      while (rightCount-- != 0) {
+        std::iter_swap(rightBase - rightOffsets[rightStart + rightCount],
+                       first);
+        first = std::next(first);
+      }
+    }
+  }
+
+  const auto pivot = std::prev(first);
+  *begin           = std::move(*pivot);
+  *pivot           = std::move(pivotValue);
+
+  return { pivot, alreadyPartitioned };
+}
+
+/**
+ * @brief Vectorized partition around the first element.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Pivot position and whether the range was already partitioned.
+ *
+ * @attention Nodiscard.
+ * @attention Requires simd::isVectorizable< Itr, Compare >.
+ * @attention Requires an element not less than the pivot in the range.
+ *
+ * @details Same contract as partitionRight. Skips the elements that are
+ * already on the correct side and hands the rest to simd::partition.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] std::pair< Itr, bool > partitionRightVectorized(Itr     begin,
+                                                              Itr     end,
+                                                              Compare compare) {
+  const auto pivotValue = *begin;
+  auto       first      = begin;
+  auto       last       = end;
+
+  do { first = std::next(first); } while (compare(*first, pivotValue));
+
+  if (std::prev(first) == begin) {
+    while (first < last) {
+      last = std::prev(last);
+      if (compare(*last, pivotValue)) { break; }
+    }
+  } else {
+    do { last = std::prev(last); } while (!compare(*last, pivotValue));
+  }
+
+  const bool alreadyPartitioned = first >= last;
+
+  if (!alreadyPartitioned) {
+    constexpr bool descending =
+      simd::isDescending< Compare, std::iter_value_t< Itr > >;
+
+    const auto base  = std::to_address(first);
+    const auto split = simd::partition< descending >(
+      base, std::to_address(std::next(last)), pivotValue);
+
+    first = std::next(first, split - base);
+  }
+
+  const auto pivot = std::prev(first);
+  *begin           = *pivot;
+  *pivot           = pivotValue;
+
+  return { pivot, alreadyPartitioned };
+}
+
+/**
+ * @brief Partition around the first element, equal elements go left.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Pivot position.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires an element not greater than the pivot before begin.
+ *
+ * @details Used when the pivot equals the element preceding the range. Then
+ * everything in [begin, pivot] is equal and needs no further sorting.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr Itr partitionLeft(Itr begin, Itr end, Compare compare) {
+  auto pivotValue = std::move(*begin);
+  auto first      = begin;
+  auto last       = end;
+
+  do { last = std::prev(last); } while (compare(pivotValue, *last));
+
+  if (std::next(last) == end) {
+    while (first < last) {
+      first = std::next(first);
+      if (compare(pivotValue, *first)) { break; }
+    }
+  } else {
+    do { first = std::next(first); } while (!compare(pivotValue, *first));
+  }
+
+  while (first < last) {
+    std::iter_swap(first, last);
+    do { last = std::prev(last); } while (compare(pivotValue, *last));
+    do { first = std::next(first); } while (!compare(pivotValue, *first));
+  }
+
+  *begin = std::move(*last);
+  *last  = std::move(pivotValue);
+
+  return last;
+}
+
+/**
+ * @brief Partition scheme used by pattern-defeating quick sort.
+ */
+enum class PartitionKind : std::uint8_t {
+  PLAIN,
+  BRANCHLESS,
+  VECTORIZED
+};
+
+/**
+ * @brief Main loop of pattern-defeating quick sort.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Kind Partition scheme.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @param badAllowed Number of highly unbalanced partitions tolerated before
+ * falling back to heap sort.
+ * @param leftmost Whether the range is the leftmost part of the array.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ */
+template< PartitionKind Kind, typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void pdqLoop(Itr            begin,
+                       Itr            end,
+                       Compare        compare,
+                       std::ptrdiff_t badAllowed,
+                       bool           leftmost) {
+  while (true) {
+    const auto size = std::distance(begin, end);
+
+    if (size < pdq::insertionThreshold) {
+      insertion::classic(begin, end, compare);
+      return;
+    }
+
+    // Median of three, or the ninther (Tukey) for larger ranges, to begin
+    const auto half   = size / 2;
+    const auto middle = std::next(begin, half);
+    if (size > pdq::nintherThreshold) {
+      sortThree(begin, middle, std::prev(end), compare);
+      sortThree(
+        std::next(begin), std::prev(middle), std::prev(end, 2), compare);
+      sortThree(
+        std::next(begin, 2), std::next(middle), std::prev(end, 3), compare);
+      sortThree(std::prev(middle), middle, std::next(middle), compare);
+      std::iter_swap(begin, middle);
+    } else {
+      sortThree(middle, begin, std::prev(end), compare);
+    }
+
+    // Pivot equal to the element preceding the range (the previous pivot):
+    // nothing in the range is smaller, so equal keys are already in place.
+    if (!leftmost && !compare(*std::prev(begin), *begin)) {
+      begin = std::next(partitionLeft(begin, end, compare));
+      continue;
+    }
+
+    const auto [pivot, alreadyPartitioned] = [&] {
+      if constexpr (Kind == PartitionKind::VECTORIZED) {
+        return partitionRightVectorized(begin, end, compare);
+      } else if constexpr (Kind == PartitionKind::BRANCHLESS) {
+        return partitionRightBranchless(begin, end, compare);
+      } else {
+        return partitionRight(begin, end, compare);
+      }
+    }();
+
+    const auto leftSize  = std::distance(begin, pivot);
+    const auto rightSize = std::distance(std::next(pivot), end);
+
+    if (leftSize < size / 8 || rightSize < size / 8) {
+      // Too many bad splits, guarantee O(n log n) with heap sort
+      if (--badAllowed == 0) {
+        heap::classic(begin, end, compare);
+        return;
+      }
+
+      // Break the pattern that caused the bad split
+      if (leftSize >= pdq::insertionThreshold) {
+        std::iter_swap(begin, std::next(begin, leftSize / 4));
+        std::iter_swap(std::prev(pivot), std::prev(pivot, leftSize / 4));
+
+        if (leftSize > pdq::nintherThreshold) {
+          std::iter_swap(std::next(begin), std::next(begin, leftSize / 4 + 1));
+          std::iter_swap(std::next(begin, 2),
+                         std::next(begin, leftSize / 4 + 2));
+          std::iter_swap(std::prev(pivot, 2),
+                         std::prev(pivot, leftSize / 4 + 1));
+          std::iter_swap(std::prev(pivot, 3),
+                         std::prev(pivot, leftSize / 4 + 2));
+        }
+      }
+
+      if (rightSize >= pdq::insertionThreshold) {
+        std::iter_swap(std::next(pivot), std::next(pivot, 1 + rightSize / 4));
+        std::iter_swap(std::prev(end), std::prev(end, rightSize / 4));
+
+        if (rightSize > pdq::nintherThreshold) {
+          std::iter_swap(std::next(pivot, 2),
+                         std::next(pivot, 2 + rightSize / 4));
+          std::iter_swap(std::next(pivot, 3),
+                         std::next(pivot, 3 + rightSize / 4));
+          std::iter_swap(std::prev(end, 2), std::prev(end, 1 + rightSize / 4));
+          std::iter_swap(std::prev(end, 3), std::prev(end, 2 + rightSize / 4));
+        }
+      }
+    } else if (alreadyPartitioned &&
+               partialInsertionSort(begin, pivot, compare) &&
+               partialInsertionSort(std::next(pivot), end, compare)) {
+      // Balanced and already partitioned, likely sorted: try to finish cheaply
+      return;
+    }
+
+    // Recurse into the left side, loop on the right side
+    pdqLoop< Kind >(begin, pivot, compare, badAllowed, leftmost);
+    begin    = std::next(pivot);
+    leftmost = false;
+  }
+}
+
+/**
+ * @brief Median of three elements.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param first Iterator to the first candidate.
+ * @param second Iterator to the second candidate.
+ * @param third Iterator to the third candidate.
+ * @param compare Comparison function.
+ * @return Iterator to the median candidate.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr Itr medianOfThree(Itr     first,
+                                          Itr     second,
+                                          Itr     third,
+                                          Compare compare) {
+  if (compare(*first, *second)) {
+    if (compare(*second, *third)) { return second; }
+    return compare(*first, *third) ? third : first;
+  }
+
+  if (compare(*first, *third)) { return first; }
+  return compare(*second, *third) ? third : second;
+}
+
+/**
+ * @brief Yaroslavskiy dual-pivot partition.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Final positions of the lower and the upper pivot.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires the pivots to be placed at the first and the last
+ * position of the range, the lower one first.
+ *
+ * @details Splits the range in one pass into elements less than the lower
+ * pivot, elements between the pivots and elements not less than the upper
+ * pivot.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr std::pair< Itr, Itr > partitionDualPivot(
+  Itr begin, Itr end, Compare compare) {
+  const auto last = std::prev(end);
+
+  // [begin + 1, less) < lower, [greater, last) >= upper, rest in between
+  auto less    = std::next(begin);
+  auto greater = last;
+  auto current = less;
+
+  while (current < greater) {
+    if (compare(*current, *begin)) {
+      std::iter_swap(current, less);
+      less = std::next(less);
+    } else if (!compare(*current, *last)) {
+      // Skip elements that already belong to the right part
+      greater = std::prev(greater);
+      while (current < greater && compare(*last, *greater)) {
+        greater = std::prev(greater);
+      }
+
+      std::iter_swap(current, greater);
+
+      if (compare(*current, *begin)) {
+        std::iter_swap(current, less);
+        less = std::next(less);
+      }
+    }
+
+    current = std::next(current);
+  }
+
+  // Move the pivots between the parts
+  less = std::prev(less);
+  std::iter_swap(begin, less);
+  std::iter_swap(last, greater);
+
+  return { less, greater };
+}
+
+/**
+ * @brief Pattern-defeating quick sort of a whole range.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Picks the vector partition when the CPU supports it and the keys
+ * allow it, the branchless partition for other arithmetic keys with the
+ * standard comparators and starts the main loop.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void pdqSort(Itr begin, Itr end, Compare compare) {
+  const auto size = std::distance(begin, end);
+  if (size < 2) { return; }
+
+  const auto badAllowed = std::bit_width(static_cast< std::size_t >(size)) - 1;
+
+  if constexpr (simd::isVectorizable< Itr, Compare >) {
+    if (!std::is_constant_evaluated() &&
+        simd::level() != simd::Level::SCALAR) {
+      pdqLoop< PartitionKind::VECTORIZED >(
+        begin, end, compare, badAllowed, true);
+      return;
+    }
+  }
+
+  constexpr bool branchless =
+    std::is_arithmetic_v< std::iter_value_t< Itr > > &&
+    isDefaultCompare< Compare, std::iter_value_t< Itr > >;
+
+  pdqLoop< branchless ? PartitionKind::BRANCHLESS : PartitionKind::PLAIN >(
+    begin, end, compare, badAllowed, true);
+}
+
+/**
+ * @brief Partial sorts of up to 1 / partialHeapRatio of the range use a
+ * bounded heap.
+ */
+inline constexpr std::ptrdiff_t partialHeapRatio = 128;
+
+/**
+ * @brief Ranges of this size or smaller are sorted sequentially.
+ */
+inline constexpr std::ptrdiff_t parallelGrain = 1 << 14;
+
+/**
+ * @brief Partition a range by a predicate.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Predicate Predicate type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param predicate Predicate, elements satisfying it go to the front.
+ * @return Iterator to the first element not satisfying the predicate.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ */
+template< typename Itr, typename Predicate >
+requires std::random_access_iterator< Itr > &&
+         std::predicate< Predicate&, std::iter_value_t< Itr > >
+constexpr Itr partitionBy(Itr begin, Itr end, Predicate predicate) {
+  while (true) {
+    while (begin != end && predicate(*begin)) { begin = std::next(begin); }
+
+    do {
+      if (begin == end) { return begin; }
+      end = std::prev(end);
+    } while (!predicate(*end));
+
+    std::iter_swap(begin, end);
+    begin = std::next(begin);
+  }
+}
+
+/**
+ * @brief Partition a range by a predicate on all threads of a pool.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Predicate Predicate type.
+ * @param pool Thread pool to run on.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param predicate Predicate, elements satisfying it go to the front.
+ * @return Iterator to the first element not satisfying the predicate.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Predicate to be safe to call concurrently.
+ *
+ * @details Every thread partitions one block of the range. The elements that
+ * ended up on the wrong side of the global split are then paired up by rank
+ * and swapped, again split evenly between the threads.
+ */
+template< typename Itr, typename Predicate >
+requires std::random_access_iterator< Itr > &&
+         std::predicate< Predicate&, std::iter_value_t< Itr > >
+Itr partitionParallel(tool::ThreadPool& pool,
+                      Itr               begin,
+                      Itr               end,
+                      Predicate         predicate) {
+  using Interval = std::pair< Itr, Itr >;
+
+  const auto size   = std::distance(begin, end);
+  const auto blocks = static_cast< std::ptrdiff_t >(pool.size() + 1);
+  const auto bound  = [&](std::ptrdiff_t block) {
+    return std::next(begin, size * block / blocks);
+  };
+
+  // Partition every block on its own
+  ds::DynamicArray< Itr > middles(static_cast< std::size_t >(blocks));
+  pool.forEach(static_cast< std::size_t >(blocks), [&](std::size_t block) {
+    const auto index = static_cast< std::ptrdiff_t >(block);
+    middles[index] = partitionBy(bound(index), bound(index + 1), predicate);
+  });
+
+  std::ptrdiff_t leftSize = 0;
+  for (std::ptrdiff_t block = 0; block < blocks; ++block) {
+    leftSize += std::distance(bound(block), middles[block]);
+  }
+  const auto split = std::next(begin, leftSize);
+
+  // Elements on the wrong side of the split, in block order
+  ds::DynamicArray< Interval > wrongLeft{};
+  ds::DynamicArray< Interval > wrongRight{};
+  std::ptrdiff_t               misplaced = 0;
+  for (std::ptrdiff_t block = 0; block < blocks; ++block) {
+    const auto middle = middles[block];
+
+    if (middle < split) {
+      const auto last = std::min(bound(block + 1), split);
+      if (middle < last) {
+        wrongLeft.push_back(Interval{ middle, last });
+        misplaced += std::distance(middle, last);
+      }
+    } else if (split < middle) {
+      const auto first = std::max(bound(block), split);
+      if (first < middle) { wrongRight.push_back(Interval{ first, middle }); }
+    }
+  }
+
+  // Locate the element of the given rank among the intervals
+  const auto locate = [](const ds::DynamicArray< Interval >& intervals,
+                         std::ptrdiff_t                      rank) {
+    std::size_t index = 0;
+    while (rank >= std::distance(intervals[index].first,
+                                 intervals[index].second)) {
+      rank -= std::distance(intervals[index].first, intervals[index].second);
+      ++index;
+    }
+    return std::pair{ index, std::next(intervals[index].first, rank) };
+  };
+
+  // Swap the n-th misplaced element on the left with the n-th on the right
+  pool.forEach(static_cast< std::size_t >(blocks), [&](std::size_t part) {
+    const auto index = static_cast< std::ptrdiff_t >(part);
+    const auto first = misplaced * index / blocks;
+    const auto last  = misplaced * (index + 1) / blocks;
+    if (first == last) { return; }
+
+    auto [leftIndex, left]   = locate(wrongLeft, first);
+    auto [rightIndex, right] = locate(wrongRight, first);
+
+    for (auto rank = first; rank < last; ++rank) {
+      if (left == wrongLeft[leftIndex].second) {
+        left = wrongLeft[++leftIndex].first;
+      }
+      if (right == wrongRight[rightIndex].second) {
+        right = wrongRight[++rightIndex].first;
+      }
+
+      std::iter_swap(left, right);
+      left  = std::next(left);
+      right = std::next(right);
+    }
+  });
+
+  return split;
+}
+
+/**
+ * @brief Parallel quick sort task.
+ * @headerfile aizo_sort_quick_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param pool Thread pool to spawn subtasks on.
+ * @param pending Number of spawned subtasks that did not finish yet.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @param depthBudget Partitioning levels left before going sequential.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Ranges large enough to keep every thread busy are partitioned in
+ * parallel, smaller ones sequentially. The smaller side of each split is
+ * spawned as a subtask, the task keeps working on the larger side. Ranges of
+ * parallelGrain elements or fewer are finished with pattern-defeating quick
+ * sort.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+void parallelTask(tool::ThreadPool&              pool,
+                  std::atomic< std::ptrdiff_t >& pending,
+                  Itr                            begin,
+                  Itr                            end,
+                  Compare                        compare,
+                  std::ptrdiff_t                 depthBudget) {
+  const auto threads = static_cast< std::ptrdiff_t >(pool.size() + 1);
+
+  while (std::distance(begin, end) > parallelGrain && depthBudget > 0) {
+    --depthBudget;
+
+    auto cut = begin;
+    if (std::distance(begin, end) > parallelGrain * threads) {
+      const auto pivotValue = *medianOfThree(
+        begin,
+        std::next(begin, std::distance(begin, end) / 2),
+        std::prev(end),
+        compare);
+
+      cut = partitionParallel(pool, begin, end, [&](const auto& value) {
+        return compare(value, pivotValue);
+      });
+
+      // Nothing less than the pivot, split off the keys equal to it instead.
+      // They are in place already.
+      if (cut == begin) {
+        begin = partitionParallel(pool, begin, end, [&](const auto& value) {
+          return !compare(pivotValue, value);
+        });
+        continue;
+      }
+    } else {
+      cut = partitionMedianOfThree(begin, end, compare);
+    }
+
+    // Spawn the smaller side, keep the larger one
+    auto spawnBegin = begin;
+    auto spawnEnd   = cut;
+    if (std::distance(begin, cut) < std::distance(cut, end)) {
+      begin = cut;
+    } else {
+      spawnBegin = cut;
+      spawnEnd   = end;
+      end        = cut;
+    }
+
+    ++pending;
+    pool.submit([&pool, &pending, spawnBegin, spawnEnd, compare, depthBudget] {
+      parallelTask(pool, pending, spawnBegin, spawnEnd, compare, depthBudget);
+      --pending;
+    });
+  }
+
+  pdqSort(begin, end, compare);
+}
+
 } // namespace aizo::sort::quick::impl
 
 #endif // UNI_AIZO_P_AIZO_SORT_QUICK_IMPL_HPP
@@ -0,0 +1,518 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_QUICK_SIMD_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_QUICK_SIMD_IMPL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+// Vector kernels are compiled for their instruction set with target
+// attributes and picked at run time, define AIZO_NO_SIMD to leave them out.
+#if !defined(AIZO_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+  (defined(__x86_64__) || defined(__i386__))
+#define AIZO_SIMD_X86 1
+#define AIZO_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define AIZO_TARGET_AVX512 __attribute__((target("avx512f,popcnt")))
+#include <immintrin.h>
+#else
+#define AIZO_SIMD_X86 0
+#endif
+
+/**
+ * @brief Vectorized partition kernels with run time instruction set dispatch.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::quick::impl::simd {
+
+/**
+ * @brief Instruction set used by the kernels.
+ */
+enum class Level : std::uint8_t {
+  SCALAR,
+  AVX2,
+  AVX512
+};
+
+/**
+ * @brief Query the CPU for the best supported instruction set.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @return Instruction set level.
+ *
+ * @attention Nodiscard.
+ */
+[[nodiscard]] inline Level detectLevel() {
+#if AIZO_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) { return Level::AVX512; }
+  if (__builtin_cpu_supports("avx2")) { return Level::AVX2; }
+#endif
+
+  return Level::SCALAR;
+}
+
+/**
+ * @brief Instruction set used by the kernels, detected once.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @return Instruction set level.
+ *
+ * @attention Nodiscard.
+ */
+[[nodiscard]] inline Level level() {
+  static const Level detected = detectLevel();
+  return detected;
+}
+
+/**
+ * @brief Check whether Type has a vector kernel.
+ *
+ * @details 32 and 64 bit signed integers and IEEE 754 floats and doubles.
+ */
+template< typename Type >
+inline constexpr bool isKey =
+  (std::signed_integral< Type > && (sizeof(Type) == 4 || sizeof(Type) == 8)) ||
+  ((std::is_same_v< Type, float > || std::is_same_v< Type, double >) &&
+   std::numeric_limits< Type >::is_iec559);
+
+/**
+ * @brief Check whether Compare orders descending.
+ */
+template< typename Compare, typename Type >
+inline constexpr bool isDescending =
+  std::is_same_v< Compare, std::greater<> > ||
+  std::is_same_v< Compare, std::greater< Type > >;
+
+/**
+ * @brief Check whether a range can be partitioned by the vector kernels.
+ *
+ * @details Contiguous storage of a key type, ordered by std::less or
+ * std::greater.
+ */
+template< typename Itr, typename Compare >
+inline constexpr bool isVectorizable =
+  std::contiguous_iterator< Itr > && isKey< std::iter_value_t< Itr > > &&
+  (isDescending< Compare, std::iter_value_t< Itr > > ||
+   std::is_same_v< Compare, std::less<> > ||
+   std::is_same_v< Compare, std::less< std::iter_value_t< Itr > > >);
+
+/**
+ * @brief Check whether an element goes in front of the pivot.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @tparam Descending Order descending.
+ * @tparam Type Element type.
+ * @param value Element.
+ * @param pivot Pivot.
+ * @return True if the element goes left.
+ *
+ * @attention Nodiscard.
+ */
+template< bool Descending, typename Type >
+[[nodiscard]] constexpr bool goesLeft(Type value, Type pivot) {
+  if constexpr (Descending) { return pivot < value; }
+  return value < pivot;
+}
+
+/**
+ * @brief Scalar partition, used for short ranges and without vector support.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @tparam Descending Order descending.
+ * @tparam Type Element type.
+ * @param begin Pointer to the beginning of the range.
+ * @param end Pointer to the end of the range.
+ * @param pivot Pivot.
+ * @return Pointer to the first element that does not go left.
+ *
+ * @attention Nodiscard.
+ */
+template< bool Descending, typename Type >
+[[nodiscard]] constexpr Type* partitionScalar(Type* begin,
+                                              Type* end,
+                                              Type  pivot) {
+  while (true) {
+    while (begin != end && goesLeft< Descending >(*begin, pivot)) { ++begin; }
+
+    do {
+      if (begin == end) { return begin; }
+      --end;
+    } while (!goesLeft< Descending >(*end, pivot));
+
+    std::swap(*begin, *end);
+    ++begin;
+  }
+}
+
+#if AIZO_SIMD_X86
+
+/**
+ * @brief Lane shuffles moving the selected lanes of a 256 bit vector to the
+ * front and the others to the back, both in lane order.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @tparam Lanes Number of lanes of the vector.
+ * @return Table of 32 bit lane indices, indexed by the selection mask.
+ *
+ * @attention Nodiscard.
+ */
+template< std::size_t Lanes >
+[[nodiscard]] consteval std::array< std::array< std::int32_t, 8 >,
+                                    std::size_t{ 1 } << Lanes >
+makePermutations() {
+  constexpr std::size_t width = 8 / Lanes;
+
+  std::array< std::array< std::int32_t, 8 >, std::size_t{ 1 } << Lanes >
+    result{};
+  for (std::size_t mask = 0; mask < result.size(); ++mask) {
+    std::size_t position = 0;
+
+    for (const bool selected : { true, false }) {
+      for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        if (((mask >> lane) & 1U) != static_cast< std::size_t >(selected)) {
+          continue;
+        }
+
+        for (std::size_t part = 0; part < width; ++part) {
+          result[mask][position++] =
+            static_cast< std::int32_t >(lane * width + part);
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief AVX2 operations on 256 bit vectors of Type.
+ */
+template< typename Type >
+struct Avx2 {
+  using Vector = __m256i;
+
+  static constexpr std::ptrdiff_t lanes = 32 / sizeof(Type);
+
+  alignas(32) static constexpr auto permutations =
+    makePermutations< static_cast< std::size_t >(lanes) >();
+
+  AIZO_TARGET_AVX2 static Vector load(const Type* source) {
+    return _mm256_loadu_si256(reinterpret_cast< const Vector* >(source));
+  }
+
+  AIZO_TARGET_AVX2 static Vector broadcast(Type value) {
+    if constexpr (sizeof(Type) == 4) {
+      return _mm256_set1_epi32(std::bit_cast< std::int32_t >(value));
+    } else {
+      return _mm256_set1_epi64x(std::bit_cast< std::int64_t >(value));
+    }
+  }
+
+  /**
+   * @brief Mask of the lanes where lhs is less than rhs.
+   */
+  AIZO_TARGET_AVX2 static unsigned less(Vector lhs, Vector rhs) {
+    if constexpr (std::is_same_v< Type, float >) {
+      return static_cast< unsigned >(_mm256_movemask_ps(_mm256_cmp_ps(
+        _mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs), _CMP_LT_OQ)));
+    } else if constexpr (std::is_same_v< Type, double >) {
+      return static_cast< unsigned >(_mm256_movemask_pd(_mm256_cmp_pd(
+        _mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs), _CMP_LT_OQ)));
+    } else if constexpr (sizeof(Type) == 4) {
+      return static_cast< unsigned >(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(rhs, lhs))));
+    } else {
+      return static_cast< unsigned >(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(rhs, lhs))));
+    }
+  }
+
+  /**
+   * @brief Write the masked lanes to left and the others to the end of right.
+   * @attention Writes whole vectors at left and right - lanes.
+   */
+  AIZO_TARGET_AVX2 static void store(Type*    left,
+                                     Type*    right,
+                                     Vector   vector,
+                                     unsigned mask) {
+    const auto permuted = _mm256_permutevar8x32_epi32(
+      vector,
+      _mm256_load_si256(
+        reinterpret_cast< const Vector* >(permutations[mask].data())));
+
+    _mm256_storeu_si256(reinterpret_cast< Vector* >(left), permuted);
+    _mm256_storeu_si256(reinterpret_cast< Vector* >(right - lanes), permuted);
+  }
+};
+
+/**
+ * @brief AVX-512 operations on 512 bit vectors of Type.
+ */
+template< typename Type >
+struct Avx512 {
+  using Vector = __m512i;
+
+  static constexpr std::ptrdiff_t lanes = 64 / sizeof(Type);
+
+  AIZO_TARGET_AVX512 static Vector load(const Type* source) {
+    return _mm512_loadu_si512(source);
+  }
+
+  AIZO_TARGET_AVX512 static Vector broadcast(Type value) {
+    if constexpr (sizeof(Type) == 4) {
+      return _mm512_set1_epi32(std::bit_cast< std::int32_t >(value));
+    } else {
+      return _mm512_set1_epi64(std::bit_cast< std::int64_t >(value));
+    }
+  }
+
+  /**
+   * @brief Mask of the lanes where lhs is less than rhs.
+   */
+  AIZO_TARGET_AVX512 static unsigned less(Vector lhs, Vector rhs) {
+    if constexpr (std::is_same_v< Type, float >) {
+      return _mm512_cmp_ps_mask(
+        _mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs), _CMP_LT_OQ);
+    } else if constexpr (std::is_same_v< Type, double >) {
+      return _mm512_cmp_pd_mask(
+        _mm512_castsi512_pd(lhs), _mm512_castsi512_pd(rhs), _CMP_LT_OQ);
+    } else if constexpr (sizeof(Type) == 4) {
+      return _mm512_cmplt_epi32_mask(lhs, rhs);
+    } else {
+      return _mm512_cmplt_epi64_mask(lhs, rhs);
+    }
+  }
+
+  /**
+   * @brief Write the masked lanes to left and the others to the end of right.
+   * @attention Writes exactly lanes elements.
+   */
+  AIZO_TARGET_AVX512 static void store(Type*    left,
+                                       Type*    right,
+                                       Vector   vector,
+                                       unsigned mask) {
+    const auto count = static_cast< std::ptrdiff_t >(std::popcount(mask));
+
+    if constexpr (sizeof(Type) == 4) {
+      _mm512_mask_compressstoreu_epi32(
+        left, static_cast< __mmask16 >(mask), vector);
+      _mm512_mask_compressstoreu_epi32(
+        right - (lanes - count), static_cast< __mmask16 >(~mask), vector);
+    } else {
+      _mm512_mask_compressstoreu_epi64(
+        left, static_cast< __mmask8 >(mask), vector);
+      _mm512_mask_compressstoreu_epi64(
+        right - (lanes - count), static_cast< __mmask8 >(~mask), vector);
+    }
+  }
+};
+
+/**
+ * @brief Place the elements left over between the read positions.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @tparam Descending Order descending.
+ * @tparam Lanes Number of lanes, more than the number of elements.
+ * @tparam Type Element type.
+ * @param readLeft Pointer to the first unread element.
+ * @param readRight Pointer past the last unread element.
+ * @param writeLeft Next position of the left part, advanced in place.
+ * @param writeRight End of the free room of the right part, moved in place.
+ * @param pivot Pivot.
+ *
+ * @details The elements are copied aside first, so the writes cannot overrun
+ * them.
+ */
+template< bool Descending, std::ptrdiff_t Lanes, typename Type >
+void placeRest(const Type* readLeft,
+               const Type* readRight,
+               Type*&      writeLeft,
+               Type*&      writeRight,
+               Type        pivot) {
+  std::array< Type, Lanes > rest{};
+  const auto last = std::copy(readLeft, readRight, rest.begin());
+
+  for (auto current = rest.begin(); current != last; ++current) {
+    if (goesLeft< Descending >(*current, pivot)) {
+      *writeLeft++ = *current;
+    } else {
+      *--writeRight = *current;
+    }
+  }
+}
+
+/**
+ * @brief AVX2 partition kernel.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @tparam Descending Order descending.
+ * @tparam Type Element type.
+ * @param begin Pointer to the beginning of the range.
+ * @param end Pointer to the end of the range.
+ * @param pivot Pivot.
+ * @return Pointer to the first element that does not go left.
+ *
+ * @attention Requires at least 2 * Avx2< Type >::lanes elements.
+ *
+ * @details The outermost vector of each side is kept in a register, which
+ * leaves room of two vectors to write into. Every step reads the next vector
+ * from the side with less room and writes its lanes to both ends, so unread
+ * elements are never overwritten.
+ */
+template< bool Descending, typename Type >
+AIZO_TARGET_AVX2 Type* partitionAvx2(Type* begin, Type* end, Type pivot) {
+  using Ops = Avx2< Type >;
+
+  const auto pivots = Ops::broadcast(pivot);
+  const auto mask   = [&](typename Ops::Vector vector) AIZO_TARGET_AVX2 {
+    return Descending ? Ops::less(pivots, vector) : Ops::less(vector, pivots);
+  };
+
+  const auto front = Ops::load(begin);
+  const auto back  = Ops::load(end - Ops::lanes);
+
+  auto* readLeft   = begin + Ops::lanes;
+  auto* readRight  = end - Ops::lanes;
+  auto* writeLeft  = begin;
+  auto* writeRight = end;
+
+  const auto place = [&](typename Ops::Vector vector) AIZO_TARGET_AVX2 {
+    const auto selected = mask(vector);
+    const auto count = static_cast< std::ptrdiff_t >(std::popcount(selected));
+
+    Ops::store(writeLeft, writeRight, vector, selected);
+    writeLeft += count;
+    writeRight -= Ops::lanes - count;
+  };
+
+  while (readRight - readLeft >= Ops::lanes) {
+    if (readLeft - writeLeft <= writeRight - readRight) {
+      place(Ops::load(readLeft));
+      readLeft += Ops::lanes;
+    } else {
+      readRight -= Ops::lanes;
+      place(Ops::load(readRight));
+    }
+  }
+
+  placeRest< Descending, Ops::lanes >(
+    readLeft, readRight, writeLeft, writeRight, pivot);
+  place(front);
+  place(back);
+
+  return writeLeft;
+}
+
+/**
+ * @brief AVX-512 partition kernel.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @tparam Descending Order descending.
+ * @tparam Type Element type.
+ * @param begin Pointer to the beginning of the range.
+ * @param end Pointer to the end of the range.
+ * @param pivot Pivot.
+ * @return Pointer to the first element that does not go left.
+ *
+ * @attention Requires at least 2 * Avx512< Type >::lanes elements.
+ *
+ * @details Same scheme as partitionAvx2, with compress stores.
+ */
+template< bool Descending, typename Type >
+AIZO_TARGET_AVX512 Type* partitionAvx512(Type* begin, Type* end, Type pivot) {
+  using Ops = Avx512< Type >;
+
+  const auto pivots = Ops::broadcast(pivot);
+  const auto mask   = [&](typename Ops::Vector vector) AIZO_TARGET_AVX512 {
+    return Descending ? Ops::less(pivots, vector) : Ops::less(vector, pivots);
+  };
+
+  const auto front = Ops::load(begin);
+  const auto back  = Ops::load(end - Ops::lanes);
+
+  auto* readLeft   = begin + Ops::lanes;
+  auto* readRight  = end - Ops::lanes;
+  auto* writeLeft  = begin;
+  auto* writeRight = end;
+
+  const auto place = [&](typename Ops::Vector vector) AIZO_TARGET_AVX512 {
+    const auto selected = mask(vector);
+    const auto count = static_cast< std::ptrdiff_t >(std::popcount(selected));
+
+    Ops::store(writeLeft, writeRight, vector, selected);
+    writeLeft += count;
+    writeRight -= Ops::lanes - count;
+  };
+
+  while (readRight - readLeft >= Ops::lanes) {
+    if (readLeft - writeLeft <= writeRight - readRight) {
+      place(Ops::load(readLeft));
+      readLeft += Ops::lanes;
+    } else {
+      readRight -= Ops::lanes;
+      place(Ops::load(readRight));
+    }
+  }
+
+  placeRest< Descending, Ops::lanes >(
+    readLeft, readRight, writeLeft, writeRight, pivot);
+  place(front);
+  place(back);
+
+  return writeLeft;
+}
+
+#endif
+
+/**
+ * @brief Partition a range around a pivot value.
+ * @headerfile aizo_sort_quick_simd_impl.hpp
+ *
+ * @tparam Descending Order descending.
+ * @tparam Type Element type.
+ * @param begin Pointer to the beginning of the range.
+ * @param end Pointer to the end of the range.
+ * @param pivot Pivot.
+ * @return Pointer to the first element that does not go left.
+ *
+ * @attention Nodiscard.
+ * @attention Requires isKey< Type >.
+ *
+ * @details Elements less than the pivot (greater for Descending) go left,
+ * the rest right, NaNs included. Uses the widest kernel the CPU supports and
+ * the scalar loop for ranges shorter than two vectors.
+ */
+template< bool Descending, typename Type >
+requires isKey< Type >
+[[nodiscard]] Type* partition(Type* begin, Type* end, Type pivot) {
+#if AIZO_SIMD_X86
+  const auto size = end - begin;
+
+  switch (level()) {
+    case Level::AVX512:
+      if (size >= 2 * Avx512< Type >::lanes) {
+        return partitionAvx512< Descending >(begin, end, pivot);
+      }
+      [[fallthrough]];
+    case Level::AVX2:
+      if (size >= 2 * Avx2< Type >::lanes) {
+        return partitionAvx2< Descending >(begin, end, pivot);
+      }
+      break;
+    case Level::SCALAR: break;
+  }
+#endif
+
+  return partitionScalar< Descending >(begin, end, pivot);
+}
+
+} // namespace aizo::sort::quick::impl::simd
+
+#endif // UNI_AIZO_P_AIZO_SORT_QUICK_SIMD_IMPL_HPP
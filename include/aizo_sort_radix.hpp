@@ -0,0 +1,88 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_RADIX_HPP
+#define UNI_AIZO_P_AIZO_SORT_RADIX_HPP
+
+#include "aizo_sort_radix_impl.hpp"
+
+/**
+ * @brief Radix sort algorithms.
+ */
+namespace aizo::sort::radix {
+
+/**
+ * @brief Least significant digit radix sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n * sizeof(key)).
+ * @headerfile aizo_sort_radix.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires the element type to be an integer or an IEEE 754 float
+ * or double.
+ * @attention Requires Compare to be std::less or std::greater.
+ *
+ * @details Sorts by 8 bit digits, starting with the least significant one,
+ * using a scratch buffer of the size of the range. Stable. Negative zero is
+ * ordered before positive zero, NaNs end up at the ends of the range
+ * according to their sign bit. Ranges of impl::insertionThreshold elements
+ * or fewer are sorted with insertion sort.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         impl::isKey< std::iter_value_t< Itr > > &&
+         (impl::isAscending< Compare, std::iter_value_t< Itr > > ||
+          impl::isDescending< Compare, std::iter_value_t< Itr > >)
+constexpr void lsd(Itr begin, Itr end, Compare /*compare*/ = Compare{}) {
+  constexpr bool descending =
+    impl::isDescending< Compare, std::iter_value_t< Itr > >;
+
+  if (std::distance(begin, end) <= impl::insertionThreshold) {
+    impl::insertionByKey< descending >(begin, end);
+    return;
+  }
+
+  impl::lsd< descending >(begin, end);
+}
+
+/**
+ * @brief In-place most significant digit radix sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n * sizeof(key)).
+ * @headerfile aizo_sort_radix.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires the element type to be an integer or an IEEE 754 float
+ * or double.
+ * @attention Requires Compare to be std::less or std::greater.
+ *
+ * @details American flag sort. Distributes the range into 256 buckets by the
+ * most significant 8 bit digit, permuting the elements in place, and recurses
+ * into the buckets with the next digit. Needs no scratch buffer, only a pair
+ * of bucket tables per recursion level. Not stable. Keys are ordered the same
+ * way as by lsd().
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         impl::isKey< std::iter_value_t< Itr > > &&
+         (impl::isAscending< Compare, std::iter_value_t< Itr > > ||
+          impl::isDescending< Compare, std::iter_value_t< Itr > >)
+constexpr void msd(Itr begin, Itr end, Compare /*compare*/ = Compare{}) {
+  using Type = std::iter_value_t< Itr >;
+
+  impl::msd< impl::isDescending< Compare, Type > >(
+    begin, end, impl::digits< Type > - 1);
+}
+
+} // namespace aizo::sort::radix
+
+#endif // UNI_AIZO_P_AIZO_SORT_RADIX_HPP
@@ -0,0 +1,341 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_RADIX_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_RADIX_IMPL_HPP
+
+#include "aizo_ds_dynamicarray.hpp"
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @brief Implementation specific functionality for radix sort algorithms.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::radix::impl {
+
+/**
+ * @brief Number of bits of a single digit.
+ */
+inline constexpr unsigned digitBits = 8;
+
+/**
+ * @brief Number of distinct digits.
+ */
+inline constexpr std::size_t radix = std::size_t{ 1 } << digitBits;
+
+/**
+ * @brief Ranges or buckets of this size or smaller are sorted with insertion
+ * sort.
+ */
+inline constexpr std::ptrdiff_t insertionThreshold = 64;
+
+/**
+ * @brief Check whether Type can be sorted by its bit pattern.
+ *
+ * @details Integers other than bool and IEEE 754 floats and doubles.
+ */
+template< typename Type >
+inline constexpr bool isKey =
+  (std::integral< Type > && !std::is_same_v< Type, bool >) ||
+  (std::floating_point< Type > && std::numeric_limits< Type >::is_iec559 &&
+   (sizeof(Type) == 4 || sizeof(Type) == 8));
+
+/**
+ * @brief Check whether Compare orders ascending.
+ */
+template< typename Compare, typename Type >
+inline constexpr bool isAscending =
+  std::is_same_v< Compare, std::less<> > ||
+  std::is_same_v< Compare, std::less< Type > >;
+
+/**
+ * @brief Check whether Compare orders descending.
+ */
+template< typename Compare, typename Type >
+inline constexpr bool isDescending =
+  std::is_same_v< Compare, std::greater<> > ||
+  std::is_same_v< Compare, std::greater< Type > >;
+
+/**
+ * @brief Unsigned integer of the same size as Type.
+ */
+template< typename Type >
+using Key = std::conditional_t<
+  sizeof(Type) == 1,
+  std::uint8_t,
+  std::conditional_t<
+    sizeof(Type) == 2,
+    std::uint16_t,
+    std::conditional_t< sizeof(Type) == 4, std::uint32_t, std::uint64_t > > >;
+
+/**
+ * @brief Number of digits of a key.
+ */
+template< typename Type >
+inline constexpr std::size_t digits = sizeof(Type) * 8 / digitBits;
+
+/**
+ * @brief Map a value to an unsigned key with the same order.
+ * @headerfile aizo_sort_radix_impl.hpp
+ *
+ * @tparam Descending Reverse the order of the keys.
+ * @tparam Type Value type.
+ * @param value Value to map.
+ * @return Unsigned key.
+ *
+ * @attention Nodiscard.
+ *
+ * @details Signed integers get their sign bit flipped. Floats with the sign
+ * bit set get all bits flipped, other floats only the sign bit. This orders
+ * -0.0 before 0.0, negative NaNs before everything and positive NaNs after
+ * everything. Descending order flips all bits once more.
+ */
+template< bool Descending, typename Type >
+requires isKey< Type >
+[[nodiscard]] constexpr Key< Type > toKey(Type value) {
+  constexpr auto sign = static_cast< Key< Type > >(Key< Type >{ 1 }
+                                                   << (sizeof(Type) * 8 - 1));
+
+  Key< Type > key{};
+  if constexpr (std::floating_point< Type >) {
+    key = std::bit_cast< Key< Type > >(value);
+    key = (key & sign) != 0 ? static_cast< Key< Type > >(~key)
+                            : static_cast< Key< Type > >(key | sign);
+  } else if constexpr (std::is_signed_v< Type >) {
+    key = static_cast< Key< Type > >(static_cast< Key< Type > >(value) ^ sign);
+  } else {
+    key = value;
+  }
+
+  if constexpr (Descending) { key = static_cast< Key< Type > >(~key); }
+
+  return key;
+}
+
+/**
+ * @brief Extract a digit of a key.
+ * @headerfile aizo_sort_radix_impl.hpp
+ *
+ * @tparam KeyType Unsigned key type.
+ * @param key Key.
+ * @param digit Index of the digit, 0 is the least significant one.
+ * @return Digit.
+ *
+ * @attention Nodiscard.
+ */
+template< std::unsigned_integral KeyType >
+[[nodiscard]] constexpr std::size_t digitOf(KeyType key, std::size_t digit) {
+  return static_cast< std::size_t >(key >> (digit * digitBits)) & (radix - 1);
+}
+
+/**
+ * @brief Insertion sort comparing the unsigned keys.
+ * @headerfile aizo_sort_radix_impl.hpp
+ *
+ * @tparam Descending Reverse the order of the keys.
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ *
+ * @details Moves a hole instead of swapping and orders exactly like the
+ * radix passes, so small ranges agree with large ones on zeros and NaNs.
+ */
+template< bool Descending, typename Itr >
+requires std::random_access_iterator< Itr >
+constexpr void insertionByKey(Itr begin, Itr end) {
+  for (auto current = begin; current != end; current = std::next(current)) {
+    auto       value = std::move(*current);
+    const auto key   = toKey< Descending >(value);
+    auto       hole  = current;
+
+    for (; hole != begin && key < toKey< Descending >(*std::prev(hole));
+         hole = std::prev(hole)) {
+      *hole = std::move(*std::prev(hole));
+    }
+    *hole = std::move(value);
+  }
+}
+
+/**
+ * @brief Stable scatter of a range by a single digit.
+ * @headerfile aizo_sort_radix_impl.hpp
+ *
+ * @tparam Descending Reverse the order of the keys.
+ * @tparam From Source iterator type.
+ * @tparam To Destination iterator type.
+ * @param begin Iterator to the beginning of the source range.
+ * @param end Iterator to the end of the source range.
+ * @param destination Iterator to the beginning of the destination range.
+ * @param offsets Exclusive prefix sums of the digit counts, advanced in place.
+ * @param digit Index of the digit.
+ *
+ * @attention Requires From and To to be at least of category
+ * RandomAccessIterator.
+ */
+template< bool Descending, typename From, typename To >
+requires std::random_access_iterator< From > &&
+         std::random_access_iterator< To >
+constexpr void scatter(From                               begin,
+                       From                               end,
+                       To                                 destination,
+                       ds::DynamicArray< std::ptrdiff_t >& offsets,
+                       std::size_t                        digit) {
+  for (auto current = begin; current != end; current = std::next(current)) {
+    const auto bucket =
+      static_cast< std::ptrdiff_t >(digitOf(toKey< Descending >(*current),
+                                            digit));
+
+    *std::next(destination, offsets[bucket]++) = std::move(*current);
+  }
+}
+
+/**
+ * @brief Least significant digit radix sort.
+ * @headerfile aizo_sort_radix_impl.hpp
+ *
+ * @tparam Descending Reverse the order of the keys.
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ *
+ * @details Counts all digits in a single pass, then scatters back and forth
+ * between the range and a scratch buffer once per digit. Digits that are
+ * equal for all keys are skipped.
+ */
+template< bool Descending, typename Itr >
+requires std::random_access_iterator< Itr >
+constexpr void lsd(Itr begin, Itr end) {
+  using Type = std::iter_value_t< Itr >;
+
+  const auto size = std::distance(begin, end);
+
+  ds::DynamicArray< std::ptrdiff_t > counts(digits< Type > * radix, 0);
+  for (auto current = begin; current != end; current = std::next(current)) {
+    const auto key = toKey< Descending >(*current);
+
+    for (std::size_t digit = 0; digit < digits< Type >; ++digit) {
+      ++counts[static_cast< std::ptrdiff_t >(digit * radix +
+                                             digitOf(key, digit))];
+    }
+  }
+
+  ds::DynamicArray< Type >           scratch(static_cast< std::size_t >(size));
+  ds::DynamicArray< std::ptrdiff_t > offsets(radix);
+  bool                               inScratch = false;
+
+  for (std::size_t digit = 0; digit < digits< Type >; ++digit) {
+    const auto histogram = std::next(
+      std::begin(counts), static_cast< std::ptrdiff_t >(digit * radix));
+    std::ptrdiff_t position = 0;
+    bool           trivial  = false;
+
+    for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+      const auto count = histogram[static_cast< std::ptrdiff_t >(bucket)];
+
+      trivial |= count == size;
+      offsets[static_cast< std::ptrdiff_t >(bucket)] = position;
+      position += count;
+    }
+
+    if (trivial) { continue; }
+
+    if (inScratch) {
+      scatter< Descending >(
+        std::begin(scratch), std::end(scratch), begin, offsets, digit);
+    } else {
+      scatter< Descending >(begin, end, std::begin(scratch), offsets, digit);
+    }
+    inScratch = !inScratch;
+  }
+
+  if (inScratch) { std::move(std::begin(scratch), std::end(scratch), begin); }
+}
+
+/**
+ * @brief In-place most significant digit radix sort (American flag sort).
+ * @headerfile aizo_sort_radix_impl.hpp
+ *
+ * @tparam Descending Reverse the order of the keys.
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param digit Index of the digit to distribute by.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ *
+ * @details Counts the digits of the range, then moves every element into its
+ * bucket by following permutation cycles, so no scratch buffer is needed.
+ * Buckets are sorted recursively by the next digit, small ones with insertion
+ * sort on the keys. The recursion depth is bounded by the number of digits.
+ */
+template< bool Descending, typename Itr >
+requires std::random_access_iterator< Itr >
+constexpr void msd(Itr begin, Itr end, std::size_t digit) {
+  const auto size = std::distance(begin, end);
+
+  if (size <= insertionThreshold) {
+    insertionByKey< Descending >(begin, end);
+    return;
+  }
+
+  std::array< std::ptrdiff_t, radix > heads{};
+  std::array< std::ptrdiff_t, radix > tails{};
+
+  for (auto current = begin; current != end; current = std::next(current)) {
+    ++tails[digitOf(toKey< Descending >(*current), digit)];
+  }
+
+  // All keys share the digit, distribute by the next one instead
+  for (const auto count : tails) {
+    if (count == size) {
+      if (digit > 0) { msd< Descending >(begin, end, digit - 1); }
+      return;
+    }
+  }
+
+  std::ptrdiff_t position = 0;
+  for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+    heads[bucket] = position;
+    position += tails[bucket];
+    tails[bucket] = position;
+  }
+
+  for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+    while (heads[bucket] < tails[bucket]) {
+      auto value  = std::move(*std::next(begin, heads[bucket]));
+      auto target = digitOf(toKey< Descending >(value), digit);
+
+      // Follow the cycle until an element of this bucket comes back
+      while (target != bucket) {
+        std::swap(value, *std::next(begin, heads[target]++));
+        target = digitOf(toKey< Descending >(value), digit);
+      }
+
+      *std::next(begin, heads[bucket]++) = std::move(value);
+    }
+  }
+
+  if (digit == 0) { return; }
+
+  auto first = begin;
+  for (std::size_t bucket = 0; bucket < radix; ++bucket) {
+    const auto last = std::next(begin, tails[bucket]);
+
+    msd< Descending >(first, last, digit - 1);
+    first = last;
+  }
+}
+
+} // namespace aizo::sort::radix::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_RADIX_IMPL_HPP
@@ -0,0 +1,130 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_SAMPLE_HPP
+#define UNI_AIZO_P_AIZO_SORT_SAMPLE_HPP
+
+#include "aizo_sort_sample_impl.hpp"
+#include "aizo_tool_threadpool.hpp"
+#include <thread>
+
+/**
+ * @brief Sample sort algorithms.
+ */
+namespace aizo::sort::sample {
+
+/**
+ * @brief Parallel sample sort algorithm.
+ * @category Sort
+ * @note Time complexity: O(n log n), O(n log n / threads) with enough cores.
+ * @headerfile aizo_sort_sample.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @param threads Number of threads to use, the calling thread included.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean
+ * and is safe to call concurrently.
+ * @attention Requires the element type to be default constructible, a
+ * scratch buffer of the size of the range is allocated.
+ *
+ * @details Picks threads * impl::bucketsPerThread - 1 splitters from an
+ * oversampled random sample. Every thread classifies its chunk of the range
+ * and counts the elements per bucket. All elements are then scattered into
+ * a DynamicArray scratch buffer in one pass, each thread writing its elements
+ * to its own contiguous slice of every bucket. The buckets are sorted
+ * concurrently with quick::pdq and moved back. Unlike recursive parallel
+ * quick sort, the first level is parallel as well. Ranges of
+ * impl::parallelGrain elements or fewer are sorted sequentially.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+void parallel(Itr         begin,
+              Itr         end,
+              Compare     compare = Compare{},
+              std::size_t threads = std::thread::hardware_concurrency()) {
+  using Type = std::iter_value_t< Itr >;
+
+  const auto size = std::distance(begin, end);
+
+  if (threads <= 1 || size <= impl::parallelGrain) {
+    quick::pdq(begin, end, compare);
+    return;
+  }
+
+  tool::ThreadPool pool{ threads - 1 };
+
+  const auto buckets   = threads * impl::bucketsPerThread;
+  const auto splitters = impl::splitters(begin, end, compare, buckets);
+
+  const auto chunk = [&](std::size_t thread) {
+    return std::next(
+      begin, size * static_cast< std::ptrdiff_t >(thread) /
+               static_cast< std::ptrdiff_t >(threads));
+  };
+
+  // Classify: bucket of every element, element count per thread and bucket
+  ds::DynamicArray< std::uint32_t > bucketOf(static_cast< std::size_t >(size));
+  ds::DynamicArray< std::ptrdiff_t > counts(threads * buckets, 0);
+  pool.forEach(threads, [&](std::size_t thread) {
+    const auto counters = static_cast< std::ptrdiff_t >(thread * buckets);
+
+    for (auto current = chunk(thread); current != chunk(thread + 1);
+         current      = std::next(current)) {
+      const auto bucket = impl::findBucket(splitters, *current, compare);
+
+      bucketOf[std::distance(begin, current)] =
+        static_cast< std::uint32_t >(bucket);
+      ++counts[counters + static_cast< std::ptrdiff_t >(bucket)];
+    }
+  });
+
+  // Exclusive prefix sum in bucket-major order gives the write positions
+  ds::DynamicArray< std::ptrdiff_t > bucketBegin(buckets + 1);
+  std::ptrdiff_t                     position = 0;
+  for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+    bucketBegin[static_cast< std::ptrdiff_t >(bucket)] = position;
+
+    for (std::size_t thread = 0; thread < threads; ++thread) {
+      auto& count =
+        counts[static_cast< std::ptrdiff_t >(thread * buckets + bucket)];
+      const auto elements = count;
+
+      count = position;
+      position += elements;
+    }
+  }
+  bucketBegin[static_cast< std::ptrdiff_t >(buckets)] = position;
+
+  // Scatter into the scratch buffer, sequential writes per thread and bucket
+  ds::DynamicArray< Type > scratch(static_cast< std::size_t >(size));
+  pool.forEach(threads, [&](std::size_t thread) {
+    const auto counters = static_cast< std::ptrdiff_t >(thread * buckets);
+
+    for (auto current = chunk(thread); current != chunk(thread + 1);
+         current      = std::next(current)) {
+      const auto bucket = bucketOf[std::distance(begin, current)];
+
+      scratch[counts[counters + bucket]++] = std::move(*current);
+    }
+  });
+
+  // Sort every bucket and move it back
+  pool.forEach(buckets, [&](std::size_t bucket) {
+    const auto index = static_cast< std::ptrdiff_t >(bucket);
+    const auto first = std::next(std::begin(scratch), bucketBegin[index]);
+    const auto last  = std::next(std::begin(scratch), bucketBegin[index + 1]);
+
+    quick::pdq(first, last, compare);
+    std::move(first, last, std::next(begin, bucketBegin[index]));
+  });
+}
+
+} // namespace aizo::sort::sample
+
+#endif // UNI_AIZO_P_AIZO_SORT_SAMPLE_HPP
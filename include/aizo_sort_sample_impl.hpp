@@ -0,0 +1,121 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_SAMPLE_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_SAMPLE_IMPL_HPP
+
+#include "aizo_ds_dynamicarray.hpp"
+#include "aizo_sort_quick.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+
+/**
+ * @brief Implementation specific functionality for sample sort algorithms.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::sample::impl {
+
+/**
+ * @brief Ranges of this size or smaller are sorted sequentially.
+ */
+inline constexpr std::ptrdiff_t parallelGrain = 1 << 16;
+
+/**
+ * @brief Number of buckets per thread, more buckets balance the load better.
+ */
+inline constexpr std::size_t bucketsPerThread = 4;
+
+/**
+ * @brief Number of samples drawn per bucket.
+ */
+inline constexpr std::size_t oversampling = 16;
+
+/**
+ * @brief Draw and sort a sample, then pick evenly spaced splitters from it.
+ * @headerfile aizo_sort_sample_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @param buckets Number of buckets.
+ * @return buckets - 1 sorted splitters.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Draws oversampling * buckets elements at pseudo-random positions,
+ * so the splitters follow the distribution of the keys closely.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] ds::DynamicArray< std::iter_value_t< Itr > > splitters(
+  Itr begin, Itr end, Compare compare, std::size_t buckets) {
+  const auto size  = static_cast< std::uint64_t >(std::distance(begin, end));
+  const auto count = buckets * oversampling;
+
+  ds::DynamicArray< std::iter_value_t< Itr > > sample(count);
+  std::uint64_t                                state = 0x9E3779B97F4A7C15ULL;
+  for (auto& element : sample) {
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    element = *std::next(begin, static_cast< std::ptrdiff_t >(state % size));
+  }
+  quick::pdq(std::begin(sample), std::end(sample), compare);
+
+  ds::DynamicArray< std::iter_value_t< Itr > > result(buckets - 1);
+  for (std::size_t i = 0; i + 1 < buckets; ++i) {
+    result[static_cast< std::ptrdiff_t >(i)] =
+      sample[static_cast< std::ptrdiff_t >((i + 1) * oversampling)];
+  }
+
+  return result;
+}
+
+/**
+ * @brief Find the bucket of an element.
+ * @headerfile aizo_sort_sample_impl.hpp
+ *
+ * @tparam Type Element type.
+ * @tparam Compare Comparison function type.
+ * @param splitters Sorted splitters.
+ * @param value Element to classify.
+ * @param compare Comparison function.
+ * @return Number of splitters not greater than the element.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Binary search with a fixed number of steps and a single
+ * comparison per step, so the compiler can turn it into conditional moves.
+ */
+template< typename Type, typename Compare >
+requires std::is_same_v< std::invoke_result_t< Compare, Type, Type >, bool >
+[[nodiscard]] constexpr std::size_t findBucket(
+  const ds::DynamicArray< Type >& splitters,
+  const Type&                     value,
+  Compare                         compare) {
+  std::size_t first = 0;
+  std::size_t size  = splitters.size();
+
+  while (size > 0) {
+    const auto half = size / 2;
+    const bool right =
+      !compare(value, splitters[static_cast< std::ptrdiff_t >(first + half)]);
+    first += right ? size - half : 0;
+    size = half;
+  }
+
+  return first;
+}
+
+} // namespace aizo::sort::sample::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_SAMPLE_IMPL_HPP
@@ -0,0 +1,89 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_SELECT_HPP
+#define UNI_AIZO_P_AIZO_SORT_SELECT_HPP
+
+#include "aizo_sort_select_impl.hpp"
+
+/**
+ * @brief Selection algorithms, order statistics without a full sort.
+ */
+namespace aizo::sort::select {
+
+/**
+ * @brief Nth element algorithm.
+ * @category Sort
+ * @note Time complexity: O(n), expected with quick selection and guaranteed
+ * by the median of medians fallback.
+ * @headerfile aizo_sort_select.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param nth Iterator to the position to select.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Places at nth the element that would be there if the range was
+ * sorted. No element of [begin, nth) is greater and no element of (nth, end)
+ * is less than it, both sides are left in unspecified order. Introselect: the
+ * pdq partitions (vectorized where quick::pdq is) narrow the range down to
+ * the side holding nth, and after log2(n) highly unbalanced partitions median
+ * of medians takes over. Does nothing if nth is end.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void nthElement(Itr     begin,
+                          Itr     nth,
+                          Itr     end,
+                          Compare compare = Compare{}) {
+  if (nth == end) { return; }
+
+  impl::introSelect(begin, nth, end, compare);
+}
+
+/**
+ * @brief Median algorithm.
+ * @category Sort
+ * @note Time complexity: O(n).
+ * @headerfile aizo_sort_select.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ * @return Iterator to the median, end for an empty range.
+ *
+ * @attention Nodiscard.
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Selects the lower median, the element at (n - 1) / 2 in sorted
+ * order, with nthElement. The range is reordered as by nthElement.
+ */
+template< typename Itr, typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+[[nodiscard]] constexpr Itr median(Itr     begin,
+                                   Itr     end,
+                                   Compare compare = Compare{}) {
+  if (begin == end) { return end; }
+
+  const auto middle = std::next(begin, (std::distance(begin, end) - 1) / 2);
+  impl::introSelect(begin, middle, end, compare);
+
+  return middle;
+}
+
+} // namespace aizo::sort::select
+
+#endif // UNI_AIZO_P_AIZO_SORT_SELECT_HPP
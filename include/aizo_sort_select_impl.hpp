@@ -0,0 +1,237 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_SELECT_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_SELECT_IMPL_HPP
+
+#include "aizo_sort_insertion.hpp"
+#include "aizo_sort_quick_impl.hpp"
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Implementation specific functionality for selection algorithms.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::select::impl {
+
+/**
+ * @brief Ranges of this size or smaller are finished with insertion sort.
+ */
+inline constexpr std::ptrdiff_t insertionThreshold = 24;
+
+/**
+ * @brief Size of the groups whose medians are the pivot candidates of median
+ * of medians.
+ */
+inline constexpr std::ptrdiff_t groupSize = 5;
+
+/**
+ * @brief Median of medians selection.
+ * @headerfile aizo_sort_select_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param nth Iterator to the position to select.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires nth to be inside the range.
+ *
+ * @details Sorts every group of groupSize elements, gathers their medians at
+ * the front and selects the median of those recursively. At least 3 / 10 of
+ * the range is not less and 3 / 10 is not greater than that pivot, so the
+ * three-way partition around it always drops a constant fraction. O(n) in the
+ * worst case, even when all keys are equal.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void medianOfMedians(Itr begin, Itr nth, Itr end, Compare compare) {
+  while (std::distance(begin, end) > insertionThreshold) {
+    const auto groups = std::distance(begin, end) / groupSize;
+
+    // Medians of the groups to the front, earlier groups are done with
+    for (std::ptrdiff_t group = 0; group < groups; ++group) {
+      const auto first = std::next(begin, group * groupSize);
+
+      insertion::classic(first, std::next(first, groupSize), compare);
+      std::iter_swap(std::next(begin, group),
+                     std::next(first, groupSize / 2));
+    }
+
+    const auto pivot = std::next(begin, groups / 2);
+    medianOfMedians(begin, pivot, std::next(begin, groups), compare);
+
+    std::iter_swap(begin, pivot);
+    const auto [equal, greater] =
+      quick::impl::partitionThreeWayFirst(begin, end, compare);
+
+    if (nth < equal) {
+      end = equal;
+    } else if (nth >= greater) {
+      begin = greater;
+    } else {
+      return;
+    }
+  }
+
+  insertion::classic(begin, end, compare);
+}
+
+/**
+ * @brief Main loop of introspective selection.
+ * @headerfile aizo_sort_select_impl.hpp
+ *
+ * @tparam Kind Partition scheme.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param nth Iterator to the position to select.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires nth to be inside the range.
+ *
+ * @details Partitions around the ninther with the pdq partitions and keeps
+ * only the side holding nth, O(n) on average. A pivot equal to the previous
+ * one sends all equal keys left at once, so ranges with many duplicates stay
+ * linear. Once log2(n) partitions have been highly unbalanced the rest is
+ * handed over to medianOfMedians.
+ */
+template< quick::impl::PartitionKind Kind, typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void introSelectLoop(Itr     begin,
+                               Itr     nth,
+                               Itr     end,
+                               Compare compare) {
+  namespace pdq = quick::impl::pdq;
+  using quick::impl::PartitionKind;
+
+  const auto leftmost   = begin;
+  auto       badAllowed = std::bit_width(
+    static_cast< std::size_t >(std::distance(begin, end)));
+
+  while (true) {
+    const auto size = std::distance(begin, end);
+
+    if (size <= insertionThreshold) {
+      insertion::classic(begin, end, compare);
+      return;
+    }
+
+    if (badAllowed == 0) {
+      medianOfMedians(begin, nth, end, compare);
+      return;
+    }
+
+    // Median of three, or the ninther (Tukey) for larger ranges, to begin
+    const auto middle = std::next(begin, size / 2);
+    if (size > pdq::nintherThreshold) {
+      quick::impl::sortThree(begin, middle, std::prev(end), compare);
+      quick::impl::sortThree(
+        std::next(begin), std::prev(middle), std::prev(end, 2), compare);
+      quick::impl::sortThree(
+        std::next(begin, 2), std::next(middle), std::prev(end, 3), compare);
+      quick::impl::sortThree(
+        std::prev(middle), middle, std::next(middle), compare);
+      std::iter_swap(begin, middle);
+    } else {
+      quick::impl::sortThree(middle, begin, std::prev(end), compare);
+    }
+
+    // Pivot equal to the previous one: [begin, pivot] holds equal keys only
+    if (begin != leftmost && !compare(*std::prev(begin), *begin)) {
+      const auto pivot = quick::impl::partitionLeft(begin, end, compare);
+
+      if (nth <= pivot) { return; }
+      begin = std::next(pivot);
+      continue;
+    }
+
+    const auto pivot = [&] {
+      if constexpr (Kind == PartitionKind::VECTORIZED) {
+        return quick::impl::partitionRightVectorized(begin, end, compare).first;
+      } else if constexpr (Kind == PartitionKind::BRANCHLESS) {
+        return quick::impl::partitionRightBranchless(begin, end, compare).first;
+      } else {
+        return quick::impl::partitionRight(begin, end, compare).first;
+      }
+    }();
+
+    if (std::distance(begin, pivot) < size / 8 ||
+        std::distance(std::next(pivot), end) < size / 8) {
+      --badAllowed;
+    }
+
+    if (nth < pivot) {
+      end = pivot;
+    } else if (pivot < nth) {
+      begin = std::next(pivot);
+    } else {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Introspective selection of a whole range.
+ * @headerfile aizo_sort_select_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param nth Iterator to the position to select.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ * @attention Requires nth to be inside the range.
+ *
+ * @details Picks the partition scheme the same way as quick::impl::pdqSort
+ * and starts the main loop.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void introSelect(Itr begin, Itr nth, Itr end, Compare compare) {
+  using quick::impl::PartitionKind;
+
+  if constexpr (quick::impl::simd::isVectorizable< Itr, Compare >) {
+    if (!std::is_constant_evaluated() &&
+        quick::impl::simd::level() != quick::impl::simd::Level::SCALAR) {
+      introSelectLoop< PartitionKind::VECTORIZED >(begin, nth, end, compare);
+      return;
+    }
+  }
+
+  constexpr bool branchless =
+    std::is_arithmetic_v< std::iter_value_t< Itr > > &&
+    quick::impl::isDefaultCompare< Compare, std::iter_value_t< Itr > >;
+
+  introSelectLoop< branchless ? PartitionKind::BRANCHLESS
+                              : PartitionKind::PLAIN >(
+    begin, nth, end, compare);
+}
+
+} // namespace aizo::sort::select::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_SELECT_IMPL_HPP
@@ -0,0 +1,121 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_SHELL_HPP
+#define UNI_AIZO_P_AIZO_SORT_SHELL_HPP
+
+#include "aizo_sort_shell_impl.hpp"
+
+/**
+ * @brief Shell sort algorithms.
+ */
+namespace aizo::sort::shell {
+
+/**
+ * @brief Gap sequences.
+ *
+ * @details Each sequence is a type with a static generate(visit) that calls
+ * visit with every gap up to impl::maxGap, 1 included, in any order. The gaps
+ * are sorted and stored in a table at compile time.
+ */
+namespace gaps {
+
+/**
+ * @brief Ciura's experimentally found gaps, extended by a factor of 2.25.
+ * @note Best known average case in practice.
+ */
+struct Ciura {
+  template< typename Visit >
+  static constexpr void generate(Visit visit) {
+    constexpr std::ptrdiff_t known[]{ 1, 4, 10, 23, 57, 132, 301, 701, 1750 };
+
+    for (const auto gap : known) { visit(gap); }
+    for (auto gap = known[8] * 9 / 4; gap <= impl::maxGap; gap = gap * 9 / 4) {
+      visit(gap);
+    }
+  }
+};
+
+/**
+ * @brief Tokuda's gaps, ceil(h) for h = 2.25 * h + 1 starting from 1.
+ */
+struct Tokuda {
+  template< typename Visit >
+  static constexpr void generate(Visit visit) {
+    for (double real = 1; real <= static_cast< double >(impl::maxGap);
+         real        = real * 2.25 + 1) {
+      const auto gap = static_cast< std::ptrdiff_t >(real);
+      visit(static_cast< double >(gap) < real ? gap + 1 : gap);
+    }
+  }
+};
+
+/**
+ * @brief Sedgewick's gaps, 4^k + 3 * 2^(k - 1) + 1 and 1.
+ * @note O(n^(4/3)) in the worst case.
+ */
+struct Sedgewick {
+  template< typename Visit >
+  static constexpr void generate(Visit visit) {
+    visit(1);
+    for (std::ptrdiff_t power = 2; power * power <= impl::maxGap; power *= 2) {
+      visit(power * power + 3 * (power / 2) + 1);
+    }
+  }
+};
+
+/**
+ * @brief Pratt's gaps, all 2^p * 3^q.
+ * @note O(n log^2 n) in the worst case, but many passes in practice.
+ */
+struct Pratt {
+  template< typename Visit >
+  static constexpr void generate(Visit visit) {
+    for (std::ptrdiff_t twos = 1; twos <= impl::maxGap; twos *= 2) {
+      for (auto gap = twos; gap <= impl::maxGap; gap *= 3) { visit(gap); }
+    }
+  }
+};
+
+} // namespace gaps
+
+/**
+ * @brief Shell sort algorithm.
+ * @category Sort
+ * @note Time complexity: depends on the gap sequence, about O(n^(4/3)).
+ * @headerfile aizo_sort_shell.hpp
+ *
+ * @tparam Gaps Gap sequence, see aizo::sort::shell::gaps.
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns a boolean.
+ *
+ * @details Insertion sorts the elements a gap apart for every gap of the
+ * sequence smaller than the range, from the largest one down to 1. Large gaps
+ * move elements far in few steps, so the final insertion sort finds an almost
+ * sorted range. In place and without recursion. Not stable.
+ */
+template< typename Gaps = gaps::Ciura,
+          typename Itr,
+          typename Compare = std::less<> >
+requires std::random_access_iterator< Itr > &&
+         std::is_same_v< std::invoke_result_t< Compare,
+                                               std::iter_value_t< Itr >,
+                                               std::iter_value_t< Itr > >,
+                         bool >
+constexpr void classic(Itr begin, Itr end, Compare compare = Compare{}) {
+  const auto  size  = std::distance(begin, end);
+  const auto& table = impl::gapTable< Gaps >;
+
+  auto gap = std::lower_bound(std::begin(table), std::end(table), size);
+  while (gap != std::begin(table)) {
+    gap = std::prev(gap);
+    impl::gapInsertion(begin, size, *gap, compare);
+  }
+}
+
+} // namespace aizo::sort::shell
+
+#endif // UNI_AIZO_P_AIZO_SORT_SHELL_HPP
@@ -0,0 +1,112 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_SHELL_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_SHELL_IMPL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Implementation specific functionality for shell sort algorithms.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::shell::impl {
+
+/**
+ * @brief Gap sequences are generated up to this gap, enough for any range
+ * that fits in memory.
+ */
+inline constexpr std::ptrdiff_t maxGap = std::ptrdiff_t{ 1 } << 40;
+
+/**
+ * @brief Number of gaps generated by a gap sequence.
+ * @headerfile aizo_sort_shell_impl.hpp
+ *
+ * @tparam Sequence Gap sequence, see aizo::sort::shell::gaps.
+ * @return Number of gaps.
+ *
+ * @attention Nodiscard.
+ */
+template< typename Sequence >
+[[nodiscard]] consteval std::size_t gapCount() {
+  std::size_t count = 0;
+  Sequence::generate([&count](std::ptrdiff_t /*gap*/) { ++count; });
+
+  return count;
+}
+
+/**
+ * @brief Gaps of a gap sequence in ascending order.
+ * @headerfile aizo_sort_shell_impl.hpp
+ *
+ * @tparam Sequence Gap sequence, see aizo::sort::shell::gaps.
+ * @return Gaps in ascending order.
+ *
+ * @attention Nodiscard.
+ */
+template< typename Sequence >
+[[nodiscard]] consteval std::array< std::ptrdiff_t, gapCount< Sequence >() >
+makeGaps() {
+  std::array< std::ptrdiff_t, gapCount< Sequence >() > result{};
+  std::size_t                                         index = 0;
+  Sequence::generate([&](std::ptrdiff_t gap) { result[index++] = gap; });
+
+  std::sort(std::begin(result), std::end(result));
+  return result;
+}
+
+/**
+ * @brief Gaps of Sequence, generated at compile time.
+ */
+template< typename Sequence >
+inline constexpr auto gapTable = makeGaps< Sequence >();
+
+/**
+ * @brief Insertion sort of the elements a gap apart.
+ * @headerfile aizo_sort_shell_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @tparam Compare Comparison function type.
+ * @param begin Iterator to the beginning of the range.
+ * @param size Size of the range.
+ * @param gap Distance between compared elements.
+ * @param compare Comparison function.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires Compare to be a function object that returns bool.
+ *
+ * @details Every element is moved out once, the larger elements before it
+ * are moved a gap forward into the hole and the element is moved into the
+ * final hole. One move per step instead of the three of a swap.
+ */
+template< typename Itr, typename Compare >
+requires std::random_access_iterator< Itr >
+constexpr void gapInsertion(Itr            begin,
+                            std::ptrdiff_t size,
+                            std::ptrdiff_t gap,
+                            Compare        compare) {
+  for (auto current = gap; current < size; ++current) {
+    if (!compare(*std::next(begin, current),
+                 *std::next(begin, current - gap))) {
+      continue;
+    }
+
+    auto value = std::move(*std::next(begin, current));
+    auto hole  = current;
+
+    do {
+      *std::next(begin, hole) = std::move(*std::next(begin, hole - gap));
+      hole -= gap;
+    } while (hole >= gap && compare(value, *std::next(begin, hole - gap)));
+
+    *std::next(begin, hole) = std::move(value);
+  }
+}
+
+} // namespace aizo::sort::shell::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_SHELL_IMPL_HPP
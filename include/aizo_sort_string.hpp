@@ -0,0 +1,72 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_STRING_HPP
+#define UNI_AIZO_P_AIZO_SORT_STRING_HPP
+
+#include "aizo_sort_string_impl.hpp"
+
+/**
+ * @brief String sorting algorithms.
+ *
+ * @details Sort ranges of strings, std::string, std::string_view or anything
+ * convertible to std::string_view, in lexicographic byte order, the order of
+ * std::less. They inspect every character of a shared prefix a bounded
+ * number of times instead of once per comparison.
+ */
+namespace aizo::sort::string {
+
+/**
+ * @brief Multikey quick sort algorithm (Bentley and Sedgewick).
+ * @category Sort
+ * @note Time complexity: O(n log n + D), D the total length of the
+ * distinguishing prefixes.
+ * @headerfile aizo_sort_string.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires the value type to be convertible to std::string_view.
+ *
+ * @details Three-way radix quick sort: partitions by a single character into
+ * less, equal and greater, and sorts the equal part by the next character.
+ * In place.
+ */
+template< typename Itr >
+requires std::random_access_iterator< Itr > &&
+         impl::isString< std::iter_value_t< Itr > >
+constexpr void multikey(Itr begin, Itr end) {
+  impl::multikey(begin, end, 0);
+}
+
+/**
+ * @brief MSD radix sort algorithm with cached prefixes.
+ * @category Sort
+ * @note Time complexity: O(n + D) passes over a dense cache, D the total
+ * length of the distinguishing prefixes.
+ * @headerfile aizo_sort_string.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires the value type to be convertible to std::string_view.
+ * @attention Requires fewer than 2^32 strings.
+ *
+ * @details Copies the next impl::prefixLength characters of every string
+ * into a dense array once and radix sorts that array byte by byte, so the
+ * character data of the strings is read sequentially once per level. The
+ * strings are then reordered once and groups sharing all cached characters
+ * repeat the process further into the strings. Small groups are finished
+ * with multikey quick sort.
+ */
+template< typename Itr >
+requires std::random_access_iterator< Itr > &&
+         impl::isString< std::iter_value_t< Itr > >
+constexpr void msd(Itr begin, Itr end) {
+  impl::msd(begin, end, 0);
+}
+
+} // namespace aizo::sort::string
+
+#endif // UNI_AIZO_P_AIZO_SORT_STRING_HPP
@@ -0,0 +1,366 @@
+#ifndef UNI_AIZO_P_AIZO_SORT_STRING_IMPL_HPP
+#define UNI_AIZO_P_AIZO_SORT_STRING_IMPL_HPP
+
+#include "aizo_ds_dynamicarray.hpp"
+#include "aizo_sort_indirect.hpp"
+#include "aizo_sort_insertion.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief Implementation specific functionality for string sorting algorithms.
+ *
+ * @warning Do not use this namespace directly.
+ */
+namespace aizo::sort::string::impl {
+
+/**
+ * @brief Element types that can be viewed as a string.
+ */
+template< typename Type >
+concept isString = std::convertible_to< const Type&, std::string_view >;
+
+/**
+ * @brief Ranges of this size or smaller are finished with insertion sort.
+ */
+inline constexpr std::ptrdiff_t insertionThreshold = 16;
+
+/**
+ * @brief Ranges of this size or smaller are handed to multikey quick sort by
+ * the MSD radix sort.
+ */
+inline constexpr std::ptrdiff_t msdThreshold = 1 << 10;
+
+/**
+ * @brief Groups of cached prefixes of this size or smaller are finished with
+ * insertion sort.
+ */
+inline constexpr std::ptrdiff_t cachedInsertionThreshold = 32;
+
+/**
+ * @brief Number of characters cached per element.
+ */
+inline constexpr std::size_t prefixLength = sizeof(std::uint64_t);
+
+/**
+ * @brief Number of buckets of a radix pass, one per byte and one for strings
+ * that ended.
+ */
+inline constexpr std::size_t bucketCount = 257;
+
+/**
+ * @brief Character of a string at a depth.
+ * @headerfile aizo_sort_string_impl.hpp
+ *
+ * @param view String to read.
+ * @param depth Position of the character.
+ * @return Character as unsigned value, -1 past the end of the string.
+ *
+ * @attention Nodiscard.
+ *
+ * @details The end of a string sorts before every character, '\0' included.
+ */
+[[nodiscard]] constexpr int charAt(std::string_view view, std::size_t depth) {
+  return depth < view.size() ? static_cast< unsigned char >(view[depth]) : -1;
+}
+
+/**
+ * @brief Insertion sort of strings sharing a common prefix.
+ * @headerfile aizo_sort_string_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param depth Length of the common prefix.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires all strings of the range to share the first depth
+ * characters.
+ *
+ * @details Compares only the suffixes after the common prefix.
+ */
+template< typename Itr >
+requires std::random_access_iterator< Itr > &&
+         isString< std::iter_value_t< Itr > >
+constexpr void insertionFrom(Itr begin, Itr end, std::size_t depth) {
+  using Type = std::iter_value_t< Itr >;
+
+  insertion::classic(
+    begin, end, [depth](const Type& first, const Type& second) -> bool {
+      return std::string_view{ first }.substr(depth) <
+             std::string_view{ second }.substr(depth);
+    });
+}
+
+/**
+ * @brief Multikey quick sort of strings sharing a common prefix.
+ * @headerfile aizo_sort_string_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param depth Length of the common prefix.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires all strings of the range to share the first depth
+ * characters.
+ *
+ * @details Three-way partitions by the character at depth around the median
+ * of three. The lesser and greater parts are sorted at the same depth, the
+ * equal part moves on to the next character in the loop, unless all of its
+ * strings ended. Every character is inspected once per partition instead of
+ * once per comparison, shared prefixes are never rescanned.
+ */
+template< typename Itr >
+requires std::random_access_iterator< Itr > &&
+         isString< std::iter_value_t< Itr > >
+constexpr void multikey(Itr begin, Itr end, std::size_t depth) {
+  const auto at = [&depth](Itr position) {
+    return charAt(std::string_view{ *position }, depth);
+  };
+
+  while (std::distance(begin, end) > insertionThreshold) {
+    const auto first  = at(begin);
+    const auto middle = at(std::next(begin, std::distance(begin, end) / 2));
+    const auto last   = at(std::prev(end));
+    const auto pivot = std::max(std::min(first, middle),
+                                std::min(std::max(first, middle), last));
+
+    // [begin, less) < pivot, [less, current) == pivot, [greater, end) > pivot
+    auto less    = begin;
+    auto current = begin;
+    auto greater = end;
+    while (current < greater) {
+      const auto character = at(current);
+
+      if (character < pivot) {
+        std::iter_swap(less, current);
+        less    = std::next(less);
+        current = std::next(current);
+      } else if (character > pivot) {
+        greater = std::prev(greater);
+        std::iter_swap(current, greater);
+      } else {
+        current = std::next(current);
+      }
+    }
+
+    multikey(begin, less, depth);
+    multikey(greater, end, depth);
+
+    // Strings that ended here are equal
+    if (pivot < 0) { return; }
+
+    begin = less;
+    end   = greater;
+    ++depth;
+  }
+
+  insertionFrom(begin, end, depth);
+}
+
+/**
+ * @brief Characters of a string cached next to its position.
+ *
+ * @details Up to prefixLength characters from the current depth, big-endian
+ * and padded with zeros, and how many of them are part of the string.
+ * Comparing prefix and then length orders the cached parts like the strings.
+ */
+struct Cached {
+  std::uint64_t prefix;
+  std::uint32_t index;
+  std::uint32_t length;
+};
+
+/**
+ * @brief Compare cached parts of strings.
+ * @headerfile aizo_sort_string_impl.hpp
+ *
+ * @param first First cached part.
+ * @param second Second cached part.
+ * @return Whether first goes before second.
+ *
+ * @attention Nodiscard.
+ */
+[[nodiscard]] constexpr bool cachedLess(const Cached& first,
+                                        const Cached& second) {
+  return first.prefix < second.prefix ||
+         (first.prefix == second.prefix && first.length < second.length);
+}
+
+/**
+ * @brief Cache the characters of a string at a depth.
+ * @headerfile aizo_sort_string_impl.hpp
+ *
+ * @param view String to cache.
+ * @param depth Position of the first cached character.
+ * @param index Position of the string in the range.
+ * @return Cached part of the string.
+ *
+ * @attention Nodiscard.
+ */
+[[nodiscard]] constexpr Cached cache(std::string_view view,
+                                     std::size_t      depth,
+                                     std::uint32_t    index) {
+  const auto length =
+    depth < view.size() ? std::min(view.size() - depth, prefixLength) : 0;
+
+  std::uint64_t prefix = 0;
+  for (std::size_t character = 0; character < prefixLength; ++character) {
+    prefix <<= 8;
+    if (character < length) {
+      prefix |= static_cast< unsigned char >(view[depth + character]);
+    }
+  }
+
+  return { prefix, index, static_cast< std::uint32_t >(length) };
+}
+
+/**
+ * @brief MSD radix sort of cached parts by one byte after another.
+ * @headerfile aizo_sort_string_impl.hpp
+ *
+ * @tparam Itr Iterator type of the cached parts.
+ * @param begin Iterator to the beginning of the cached parts.
+ * @param end Iterator to the end of the cached parts.
+ * @param scratch Iterator to a buffer of the same size.
+ * @param byte Position of the byte to distribute by, 0 is the first.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires all cached parts of the range to share the first byte
+ * bytes.
+ *
+ * @details Counting sort into bucketCount buckets, cached parts whose string
+ * ended before the byte go to the first bucket and need no further sorting.
+ * Only the dense cache is read, the strings are never touched.
+ */
+template< typename Itr >
+requires std::random_access_iterator< Itr >
+constexpr void msdCached(Itr begin, Itr end, Itr scratch, std::size_t byte) {
+  const auto size = std::distance(begin, end);
+
+  if (size <= cachedInsertionThreshold) {
+    insertion::classic(begin, end, cachedLess);
+    return;
+  }
+  if (byte == prefixLength) { return; }
+
+  const auto bucketOf = [byte](const Cached& cached) -> std::size_t {
+    if (byte >= cached.length) { return 0; }
+
+    return 1 + ((cached.prefix >> (8 * (prefixLength - 1 - byte))) & 0xFF);
+  };
+
+  std::array< std::ptrdiff_t, bucketCount + 1 > offsets{};
+  for (auto current = begin; current != end; current = std::next(current)) {
+    ++offsets[bucketOf(*current) + 1];
+  }
+  for (std::size_t bucket = 1; bucket <= bucketCount; ++bucket) {
+    offsets[bucket] += offsets[bucket - 1];
+  }
+
+  auto positions = offsets;
+  for (auto current = begin; current != end; current = std::next(current)) {
+    *std::next(scratch, positions[bucketOf(*current)]++) = *current;
+  }
+  std::copy(scratch, std::next(scratch, size), begin);
+
+  for (std::size_t bucket = 1; bucket < bucketCount; ++bucket) {
+    if (offsets[bucket + 1] - offsets[bucket] < 2) { continue; }
+
+    msdCached(std::next(begin, offsets[bucket]),
+              std::next(begin, offsets[bucket + 1]),
+              std::next(scratch, offsets[bucket]),
+              byte + 1);
+  }
+}
+
+/**
+ * @brief MSD radix sort of strings sharing a common prefix.
+ * @headerfile aizo_sort_string_impl.hpp
+ *
+ * @tparam Itr Iterator type.
+ * @param begin Iterator to the beginning of the range.
+ * @param end Iterator to the end of the range.
+ * @param depth Length of the common prefix.
+ *
+ * @attention Requires Itr to be at least of category RandomAccessIterator.
+ * @attention Requires all strings of the range to share the first depth
+ * characters and fewer than 2^32 strings.
+ *
+ * @details Caches the next prefixLength characters of every string once,
+ * sorts the cache with msdCached from the first byte that differs and
+ * reorders the strings by it in a single pass. Groups that still share all
+ * cached characters are sorted again from depth + prefixLength. Characters
+ * shared by the whole range are skipped without reordering anything. Small
+ * ranges go to multikey quick sort.
+ */
+template< typename Itr >
+requires std::random_access_iterator< Itr > &&
+         isString< std::iter_value_t< Itr > >
+constexpr void msd(Itr begin, Itr end, std::size_t depth) {
+  const auto size = std::distance(begin, end);
+
+  if (size <= msdThreshold) {
+    multikey(begin, end, depth);
+    return;
+  }
+
+  ds::DynamicArray< Cached > cached(static_cast< std::size_t >(size));
+  ds::DynamicArray< Cached > scratch(static_cast< std::size_t >(size));
+
+  // Cache the next characters, skipping those shared by all strings
+  std::uint64_t differing = 0;
+  std::size_t   shortest  = prefixLength;
+  while (differing == 0 && shortest == prefixLength) {
+    for (std::ptrdiff_t index = 0; index < size; ++index) {
+      cached[index] = cache(std::string_view{ *std::next(begin, index) },
+                            depth,
+                            static_cast< std::uint32_t >(index));
+
+      differing |= cached[index].prefix ^ cached[0].prefix;
+      shortest   = std::min< std::size_t >(shortest, cached[index].length);
+    }
+
+    if (differing == 0 && shortest == prefixLength) { depth += prefixLength; }
+  }
+
+  // Bytes shared by all cached parts need no counting pass
+  const auto shared = std::min(
+    static_cast< std::size_t >(std::countl_zero(differing)) / 8, shortest);
+
+  msdCached(std::begin(cached), std::end(cached), std::begin(scratch), shared);
+
+  ds::DynamicArray< std::uint32_t > indices(static_cast< std::size_t >(size));
+  for (std::ptrdiff_t index = 0; index < size; ++index) {
+    indices[index] = cached[index].index;
+  }
+  applyPermutation(begin, end, std::begin(indices));
+
+  // Groups equal in all cached characters continue after them
+  for (std::ptrdiff_t first = 0; first < size;) {
+    auto last = first + 1;
+    while (last < size && cached[last].prefix == cached[first].prefix &&
+           cached[last].length == cached[first].length) {
+      ++last;
+    }
+
+    if (last - first > 1 && cached[first].length == prefixLength) {
+      msd(std::next(begin, first),
+          std::next(begin, last),
+          depth + prefixLength);
+    }
+    first = last;
+  }
+}
+
+} // namespace aizo::sort::string::impl
+
+#endif // UNI_AIZO_P_AIZO_SORT_STRING_IMPL_HPP
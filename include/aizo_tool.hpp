@@ -10,5 +10,6 @@ namespace aizo::tool {
 #include "aizo_tool_timer.hpp"
 #include "aizo_tool_arrayreader.hpp"
 #include "aizo_tool_arraygenerator.hpp"
+#include "aizo_tool_threadpool.hpp"
 
 #endif // UNI_AIZO_P_AIZO_TOOL_HPP
@@ -0,0 +1,209 @@
+#ifndef UNI_AIZO_P_AIZO_TOOL_THREADPOOL_HPP
+#define UNI_AIZO_P_AIZO_TOOL_THREADPOOL_HPP
+
+#include "aizo_ds_dynamicarray.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace aizo::tool {
+
+/**
+ * @brief Work-stealing thread pool.
+ * @headerfile aizo_tool_threadpool.hpp
+ *
+ * @details Every worker owns a task queue. Tasks submitted from a worker go to
+ * its own queue and are taken back in LIFO order, which keeps recursive work
+ * cache-local. Idle workers steal the oldest tasks of other workers. Tasks
+ * submitted from outside the pool are spread round-robin.
+ *
+ * @note Threads waiting for their tasks should call runPendingTask() in a loop
+ * instead of blocking, so nested parallelism cannot deadlock the pool.
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Construct a new Thread Pool object and start the workers.
+   * @param threadCount Number of worker threads. May be 0, then tasks only run
+   * when the owner calls runPendingTask().
+   */
+  explicit ThreadPool(std::size_t threadCount):
+    queues{ threadCount == 0 ? 1 : threadCount },
+    workers{ threadCount } {
+    for (std::size_t i = 0; i < threadCount; ++i) {
+      workers[i] = std::thread{ [this, i] { work(i); } };
+    }
+  }
+
+  ThreadPool(const ThreadPool&)            = delete;
+  ThreadPool(ThreadPool&&)                 = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&)      = delete;
+
+  /**
+   * @brief Stop the workers. Tasks that were not started are dropped.
+   */
+  ~ThreadPool() {
+    {
+      const std::scoped_lock lock{ wakeMutex };
+      stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers) { worker.join(); }
+  }
+
+  /**
+   * @brief Queue a task.
+   * @param task Task to run.
+   */
+  void submit(std::function< void() > task) {
+    const auto index = currentPool == this
+                         ? currentIndex
+                         : roundRobin.fetch_add(1) % queues.size();
+
+    {
+      const std::scoped_lock lock{ queues[index].mutex };
+      queues[index].tasks.push_back(std::move(task));
+    }
+
+    {
+      const std::scoped_lock lock{ wakeMutex };
+      ++queued;
+    }
+    wake.notify_one();
+  }
+
+  /**
+   * @brief Run one queued task on the calling thread.
+   * @return True if a task was run, false if there was nothing to do.
+   */
+  bool runPendingTask() {
+    const auto start = currentPool == this ? currentIndex : 0;
+
+    if (auto task = take(start)) {
+      task();
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Run body(0) ... body(count - 1) in parallel and wait for all.
+   * @tparam Body Callable taking the index of the part.
+   * @param count Number of parts.
+   * @param body Work of a single part.
+   *
+   * @details The calling thread runs part 0 and keeps running queued tasks
+   * until all parts are done, so it may be called from inside a task.
+   */
+  template< typename Body >
+  requires std::invocable< Body&, std::size_t >
+  void forEach(std::size_t count, Body body) {
+    std::atomic< std::size_t > remaining{ count };
+
+    for (std::size_t i = 1; i < count; ++i) {
+      submit([&body, &remaining, i] {
+        body(i);
+        --remaining;
+      });
+    }
+
+    if (count > 0) {
+      body(0);
+      --remaining;
+    }
+
+    while (remaining != 0) {
+      if (!runPendingTask()) { std::this_thread::yield(); }
+    }
+  }
+
+  /**
+   * @brief Get the number of worker threads.
+   * @note Nodiscard.
+   * @return Number of worker threads.
+   */
+  [[nodiscard]] std::size_t size() const {
+    return workers.size();
+  }
+
+private:
+  struct Queue {
+    std::mutex                            mutex;
+    std::deque< std::function< void() > > tasks;
+  };
+
+  static inline thread_local const ThreadPool* currentPool{ nullptr };
+  static inline thread_local std::size_t       currentIndex{ 0 };
+
+  ds::DynamicArray< Queue >       queues;
+  ds::DynamicArray< std::thread > workers;
+  std::mutex                      wakeMutex;
+  std::condition_variable         wake;
+  std::ptrdiff_t                  queued{ 0 };
+  bool                            stopping{ false };
+  std::atomic< std::size_t >      roundRobin{ 0 };
+
+  /**
+   * @brief Take a task, own queue first (newest), then steal (oldest).
+   * @param own Index of the queue of the calling thread.
+   * @return Task, empty if all queues are empty.
+   */
+  std::function< void() > take(std::size_t own) {
+    std::function< void() > task{};
+
+    {
+      const std::scoped_lock lock{ queues[own].mutex };
+      if (!queues[own].tasks.empty()) {
+        task = std::move(queues[own].tasks.back());
+        queues[own].tasks.pop_back();
+      }
+    }
+
+    for (std::size_t offset = 1; !task && offset < queues.size(); ++offset) {
+      auto& victim = queues[(own + offset) % queues.size()];
+
+      const std::scoped_lock lock{ victim.mutex };
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+      }
+    }
+
+    if (task) {
+      const std::scoped_lock lock{ wakeMutex };
+      --queued;
+    }
+
+    return task;
+  }
+
+  /**
+   * @brief Worker loop.
+   * @param index Index of the worker.
+   */
+  void work(std::size_t index) {
+    currentPool  = this;
+    currentIndex = index;
+
+    while (true) {
+      if (auto task = take(index)) {
+        task();
+        continue;
+      }
+
+      std::unique_lock lock{ wakeMutex };
+      wake.wait(lock, [this] { return stopping || queued > 0; });
+      if (stopping) { return; }
+    }
+  }
+};
+
+} // namespace aizo::tool
+
+#endif // UNI_AIZO_P_AIZO_TOOL_THREADPOOL_HPP